@@ -26,13 +26,14 @@
 #define RMTDHT_PERIOD_MS  2000U     ///< Higher than 8 * 0.2s, so RMT blinks will not overlap.
 
 // #2: Channels / wires / addresses
-#define RMTDHT_GPIO         21U
-#define RMTDHT_CH           RMT_CH0
+#define RMTDHT_COUNT         2U     ///< Sensors measured in the same time window (a missing sensor is reported).
 #define RMTINT_CH           23U
 
 // ============= Local types ===============
 
 // ================ Local function declarations =================
+static void _print_data(uint8_t u8Idx, const SDht22Data *psParam);
+static void _done_rx(void *pvParam, SDht22Group *psGroup);
 static void _rmtdht_init();
 static void _rmtdht_cycle(uint64_t u64Ticks);
 
@@ -40,39 +41,61 @@ static void _rmtdht_cycle(uint64_t u64Ticks);
 const bool gbStartAppCpu = START_APP_CPU;
 const uint16_t gu16Tim00Divisor = TIM0_0_DIVISOR;
 const uint64_t gu64tckSchedulePeriod = (CLK_FREQ_HZ / SCHEDULE_FREQ_HZ);
+const uint8_t gau8DhtGpio[RMTDHT_COUNT] = {21U, 22U};
+const ERmtChannel gaeDhtChannel[RMTDHT_COUNT] = {RMT_CH0, RMT_CH1};
 
 // ==================== Local Data ================
-static SDht22Descriptor gsDht22Desc;
+static SDht22Descriptor gasDht22Desc[RMTDHT_COUNT];
+static SDht22Group gsDht22Group;
 
 // ==================== Implementation ================
 
-void _done_rx(void *pvParam, SDht22Data *psParam) {
-  uart_printf(&gsUART0, "INVALID: %02X %02X %02X %02X %02X\n",
+static void _print_data(uint8_t u8Idx, const SDht22Data *psParam) {
+  uart_printf(&gsUART0, "#%u INVALID: %02X %02X %02X %02X %02X\n",
+          u8Idx,
           psParam->au8Invalid[0],
           psParam->au8Invalid[1],
           psParam->au8Invalid[2],
           psParam->au8Invalid[3],
           psParam->au8Invalid[4]
           );
-  uart_printf(&gsUART0, "DATA: %02X %02X %02X %02X %02X\n",
+  uart_printf(&gsUART0, "#%u DATA: %02X %02X %02X %02X %02X\n",
+          u8Idx,
           psParam->au8Data[0],
           psParam->au8Data[1],
           psParam->au8Data[2],
           psParam->au8Data[3],
           psParam->au8Data[4]
           );
-  uart_printf(&gsUART0, "raw data (%c) T: %d, RH: %u\n",
+  uart_printf(&gsUART0, "#%u raw data (%c) T: %d, RH: %u\n",
+          u8Idx,
           dht22_data_valid(psParam) ? '+' : '-',
           dht22_get_temp(psParam),
           dht22_get_rhum(psParam)
           );
 }
 
+/**
+ * Group callback: prints the data of every sensor that has answered in the current round.
+ */
+static void _done_rx(void *pvParam, SDht22Group *psGroup) {
+  for (uint8_t i = 0; i < psGroup->u8Count; ++i) {
+    if (psGroup->u8ReadyMask & (1 << i)) {
+      _print_data(i, &psGroup->asDesc[i].sData);
+    } else {
+      uart_printf(&gsUART0, "#%u no answer\n", i);
+    }
+  }
+}
+
 static void _rmtdht_init() {
   rmt_isr_init();
   rmt_init_controller(true, true);
-  gsDht22Desc = dht22_config(RMTDHT_CH, _done_rx, NULL);
-  dht22_init(RMTDHT_GPIO, APB_FREQ_HZ, &gsDht22Desc);
+  for (uint8_t i = 0; i < RMTDHT_COUNT; ++i) {
+    gasDht22Desc[i] = dht22_config(gaeDhtChannel[i], NULL, NULL);
+    dht22_init(gau8DhtGpio[i], APB_FREQ_HZ, &gasDht22Desc[i]);
+  }
+  dht22_group_init(&gsDht22Group, gasDht22Desc, RMTDHT_COUNT, _done_rx, NULL);
 
   rmt_isr_start(CPU_PRO, RMTINT_CH);
 }
@@ -81,7 +104,7 @@ static void _rmtdht_cycle(uint64_t u64Ticks) {
   static uint64_t u64NextTick = 0;
 
   if (u64NextTick <= u64Ticks) {
-    dht22_run(&gsDht22Desc);
+    dht22_group_run(&gsDht22Group);
 
     u64NextTick += MS2TICKS(RMTDHT_PERIOD_MS);
   }
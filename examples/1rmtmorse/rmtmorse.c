@@ -59,7 +59,7 @@ static uint16_t _mph_to_entry(EMorsePhase ePhase);
 static uint16_t _mph2entry_next(void *pvState);
 static bool _mph2entry_end(const void *pvState);
 
-static void _rmt_config_channel(ERmtChannel eChannel, bool bLevel, bool bHoldLevel);
+static bool _rmt_config_channel(ERmtChannel eChannel, bool bLevel, bool bHoldLevel);
 static void _rmtmorse_init();
 static void _rmtmorse_cycle(uint64_t u64Ticks);
 
@@ -78,6 +78,7 @@ const uint16_t gau16msPhaseLen[] = {
   0
 };
 const char acMessage[] = MESSAGE;
+static bool gbRmtReady = false; ///< The RMT RAM blocks could be allocated.
 
 // ==================== Implementation ================
 
@@ -118,13 +119,18 @@ static bool _mph2entry_end(const void *pvState) {
   return mphgen_end(psState);
 }
 
-static void _rmt_config_channel(ERmtChannel eChannel, bool bLevel, bool bHoldLevel) {
+static bool _rmt_config_channel(ERmtChannel eChannel, bool bLevel, bool bHoldLevel) {
+  // set memory size and ownership of RMT RAM blocks
+  if (!rmt_ram_alloc(eChannel, RMTMORSE_MEM_BLOCKS, false)) {
+    return false;
+  }
+
   // rmt channel config
   SRmtChConf rChConf = {
     .r0 =
     {.u8DivCnt = RMT_DIVISOR, .u4MemSize = RMTMORSE_MEM_BLOCKS, .bCarrierEn = CARRIER_EN, .bCarrierOutLvl = 1},
     .r1 =
-    {.bRefAlwaysOn = 1, .bRefCntRst = 1, .bMemRdRst = 1, .bIdleOutLvl = bLevel, .bIdleOutEn = bHoldLevel}
+    {.bRefAlwaysOn = 1, .bRefCntRst = 1, .bMemRdRst = 1, .bIdleOutLvl = bLevel, .bIdleOutEn = bHoldLevel, .bMemOwner = 0}
   };
   gpsRMT->asChConf[eChannel] = rChConf;
 
@@ -133,13 +139,6 @@ static void _rmt_config_channel(ERmtChannel eChannel, bool bLevel, bool bHoldLev
     gpsRMT->arCarrierDuty[eChannel] = rChCarr;
   }
 
-  // set memory ownership of RMT RAM blocks
-  SRmtChConf1Reg sRdMemCfg = {.raw = -1};
-  sRdMemCfg.bMemOwner = 0;
-  for (int i = 0; i < RMTMORSE_MEM_BLOCKS; ++i) {
-    gpsRMT->asChConf[(eChannel + i) % RMT_CHANNEL_NUM].r1.raw &= sRdMemCfg.raw;
-  }
-
   gpsRMT->arTxLim[eChannel].u9Val = RMT_TXLIM; // half of the memory block
 
   // Note: in this example we do not register ISRs
@@ -148,12 +147,13 @@ static void _rmt_config_channel(ERmtChannel eChannel, bool bLevel, bool bHoldLev
           rmt_int_bit(eChannel, RMT_INT_TXEND) |
           rmt_int_bit(eChannel, RMT_INT_TXTHRES) |
           rmt_int_bit(eChannel, RMT_INT_ERR);
+  return true;
 }
 
 static void _rmtmorse_init() {
   rmt_init_controller(true, true);
   rmt_init_channel(RMTMORSE_CH, RMTMORSE_GPIO, false);
-  _rmt_config_channel(RMTMORSE_CH, 0, 0);
+  gbRmtReady = _rmt_config_channel(RMTMORSE_CH, 0, 0);
 
   // we do some logging, hence set UART0 speed
   gsUART0.CLKDIV.u20ClkDiv = APB_FREQ_HZ / 115200;
@@ -164,19 +164,22 @@ static void _rmtmorse_cycle(uint64_t u64Ticks) {
 
   static SByteGenState sByteGenState;
   static SMphGenState sMphGenState;
-  static SStretchGenState sSGenState;
+  static SRlStretchGenState sSGenState;
   static bool bFirstRun = true;
   static bool bFeedReady = false;
   static uint16_t u16RmtMemPos = 0;
 
+  if (!gbRmtReady) {
+    return;
+  }
   if (bFirstRun) {
     sByteGenState = bytegen_init((uint8_t*)acMessage, ARRAY_SIZE(acMessage) - 1);
     sMphGenState = mphgen_init(&sByteGenState, true);
-    sSGenState = rmtutils_init_stretchgenstate(
+    sSGenState = rmtutils_init_rlstretchgenstate(
             HZ2APBTICKS(1000) / RMT_DIVISOR, 1,
             _mph2entry_next, _mph2entry_end, &sMphGenState);
 
-    bFeedReady = rmtutils_feed_tx_stretched(RMTMORSE_CH, &u16RmtMemPos, RMT_FEED0SIZE, (void*) &sSGenState);
+    bFeedReady = rmtutils_feed_tx_rlstretched(RMTMORSE_CH, &u16RmtMemPos, RMT_FEED0SIZE, (void*) &sSGenState);
     rmt_start_tx(RMTMORSE_CH, true);
 
     bFirstRun = false;
@@ -188,7 +191,7 @@ static void _rmtmorse_cycle(uint64_t u64Ticks) {
       gpsRMT->arInt[RMT_INT_CLR] = rmt_int_bit(RMTMORSE_CH, RMT_INT_TXTHRES);
       if (!bFeedReady) {
         gsUART0.FIFO = 'F';
-        bFeedReady = rmtutils_feed_tx_stretched(RMTMORSE_CH, &u16RmtMemPos, RMT_TXLIM, (void*) &sSGenState);
+        bFeedReady = rmtutils_feed_tx_rlstretched(RMTMORSE_CH, &u16RmtMemPos, RMT_TXLIM, (void*) &sSGenState);
       }
     }
     if (gpsRMT->arInt[RMT_INT_ST] & rmt_int_bit(RMTMORSE_CH, RMT_INT_TXEND)) {
@@ -196,7 +199,7 @@ static void _rmtmorse_cycle(uint64_t u64Ticks) {
       gsUART0.FIFO = '\n';
       mphgen_reset(&sMphGenState);
       u16RmtMemPos = 0U;
-      bFeedReady = rmtutils_feed_tx_stretched(RMTMORSE_CH, &u16RmtMemPos, RMT_FEED0SIZE, (void*) &sSGenState);
+      bFeedReady = rmtutils_feed_tx_rlstretched(RMTMORSE_CH, &u16RmtMemPos, RMT_FEED0SIZE, (void*) &sSGenState);
       rmt_start_tx(RMTMORSE_CH, true);
     }
     if (gpsRMT->arInt[RMT_INT_ST] & rmt_int_bit(RMTMORSE_CH, RMT_INT_ERR)) {
@@ -66,7 +66,7 @@ typedef struct {
 static uint8_t _period_to_entrypair(uint32_t *pu32Dest, uint8_t u8DestSize, uint32_t u32Period, bool bLevel);
 static uint8_t _note_to_registers(uint32_t *pu32CDuty, uint32_t *pu32RamBuf, uint8_t u8BufLen, const SMusicNote *psNote, uint8_t *pu8HiLen);
 
-static void _rmt_config_channel(ERmtChannel eChannel, bool bLevel, bool bHoldLevel);
+static bool _rmt_config_channel(ERmtChannel eChannel, bool bLevel, bool bHoldLevel);
 static void _rmtmusic_init();
 static void _rmtmusic_cycle(uint64_t u64Ticks);
 
@@ -110,6 +110,7 @@ static SMusicNote *gapsMusicRotation[ARRAY_SIZE(gasVarShift) + 1][2]; ///< There
 static uint32_t gau32RotationLen[ARRAY_SIZE(gasVarShift) + 1]; ///< This array will contain the length of the follower musics.
 
 static SMusicRmtStateDesc gsMusicState; ///< ISR parameter
+static bool gbRmtReady = false; ///< The RMT RAM blocks could be allocated.
 
 // ==================== Implementation ================
 
@@ -179,14 +180,18 @@ static uint8_t _note_to_registers(uint32_t *pu32CDuty, uint32_t *pu32RamBuf, uin
   return u8Ret;
 }
 
-static void _rmt_config_channel(ERmtChannel eChannel, bool bLevel, bool bHoldLevel) {
-  // rmt channel config
+static bool _rmt_config_channel(ERmtChannel eChannel, bool bLevel, bool bHoldLevel) {
+  // set memory size and ownership of RMT RAM blocks
+  if (!rmt_ram_alloc(eChannel, RMTMUSIC_MEM_BLOCKS, false)) {
+    return false;
+  }
+
   // rmt channel config
   SRmtChConf rChConf = {
     .r0 =
     {.u8DivCnt = RMT_DIVISOR, .u4MemSize = RMTMUSIC_MEM_BLOCKS, .bCarrierEn = 1, .bCarrierOutLvl = 1},
     .r1 =
-    {.bRefAlwaysOn = 0, .bRefCntRst = 1, .bMemRdRst = 1, .bIdleOutLvl = bLevel, .bIdleOutEn = bHoldLevel}
+    {.bRefAlwaysOn = 0, .bRefCntRst = 1, .bMemRdRst = 1, .bIdleOutLvl = bLevel, .bIdleOutEn = bHoldLevel, .bMemOwner = 0}
   };
   gpsRMT->asChConf[eChannel] = rChConf;
 
@@ -195,15 +200,8 @@ static void _rmt_config_channel(ERmtChannel eChannel, bool bLevel, bool bHoldLev
     gpsRMT->arCarrierDuty[eChannel] = rChCarr;
   }
 
-  // set memory ownership of RMT RAM blocks
-  SRmtChConf1Reg sRdMemCfg = {.raw = -1};
-  sRdMemCfg.bMemOwner = 0;
-  for (int i = 0; i < RMTMUSIC_MEM_BLOCKS; ++i) {
-
-    gpsRMT->asChConf[(eChannel + i) % RMT_CHANNEL_NUM].r1.raw &= sRdMemCfg.raw;
-  }
-
   gpsRMT->arTxLim[eChannel].u9Val = RMT_TXLIM; // half of the memory block
+  return true;
 }
 
 IRAM_ATTR void _rmtmusic_feed(void *pvParam) {
@@ -258,7 +256,10 @@ static void _rmtmusic_init() {
   // initialize MCU parts
   rmt_init_controller(true, true);
   rmt_init_channel(RMTMUSIC_CH, RMTMUSIC_GPIO, false);
-  _rmt_config_channel(RMTMUSIC_CH, 0, 0);
+  gbRmtReady = _rmt_config_channel(RMTMUSIC_CH, 0, 0);
+  if (!gbRmtReady) {
+    return;
+  }
 
   // we do some logging, hence set UART0 speed
   gsUART0.CLKDIV.u20ClkDiv = APB_FREQ_HZ / 115200;
@@ -273,7 +274,7 @@ static void _rmtmusic_cycle(uint64_t u64Ticks) {
   static uint64_t u64NextTick = MS2TICKS(UPDATE_PERIOD_MS);
   static bool bFirstRun = true;
 
-  if (u64NextTick <= u64Ticks) {
+  if (gbRmtReady && u64NextTick <= u64Ticks) {
     if (bFirstRun) {
       gsMusicState = (SMusicRmtStateDesc){
         .psMusic = gasMusic,
@@ -0,0 +1,217 @@
+/*
+ * Copyright 2025 SZIGETI János
+ *
+ * This file is part of Bilis ESP32 Basic, which is released under GNU General Public License.version 3.
+ * See LICENSE or <https://www.gnu.org/licenses/> for full license details.
+ */
+#include <stdbool.h>
+#include <inttypes.h>
+#include <stddef.h>
+
+#include "gpio.h"
+#include "main.h"
+#include "rmt.h"
+#include "defines.h"
+#include "romfunctions.h"
+#include "iomux.h"
+#include "uart.h"
+#include "utils/rmtrx.h"
+#include "utils/uartutils.h"
+
+// =================== Hard constants =================
+// #1: Timings
+#define RMTRXLOOP_PERIOD_MS  1000U     ///< A frame is sent in every second.
+#define RMT_DIVISOR            80U     ///< RMT TICK freq is 80MHz / RMT_DIVISOR (80 -> 1MHz)
+
+// pulse distance coding (NEC-like), in µs
+#define FRAME_LEAD_MARK_US   9000U
+#define FRAME_LEAD_SPACE_US  4500U
+#define FRAME_MARK_US         560U
+#define FRAME_SPACE0_US       560U
+#define FRAME_SPACE1_US      1690U
+#define FRAME_BITS             32U
+
+#define FRAME_SPACE_THRES_US ((FRAME_SPACE0_US + FRAME_SPACE1_US) / 2)  ///< Longer spaces are bit 1.
+#define FRAME_LEAD_MIN_US    3000U     ///< Shorter spaces are data bits.
+#define FRAME_LEAD_MAX_US    6000U     ///< Longer spaces are not part of the frame.
+#define RMTRX_IDLE_US       10000U     ///< The frame is over, if the signal is constant for that long.
+#define RMTRX_FILTER_THRES    100U     ///< RMT filters out spikes shorter than that many APB clocks.
+
+// #2: Channels / wires / addresses
+#define RMTRXLOOP_GPIO         21U     ///< Both the transmitter and the receiver use this pin (no wiring needed).
+#define RMTTX_CH           RMT_CH0
+#define RMTRX_CH           RMT_CH1
+#define RMTTX_MEM_BLOCKS        1U     ///< Lead + 32 bits + stop = 34 registers.
+#define RMTRX_MEM_BLOCKS        1U     ///< 68 entries + end marker fit into RMTRX_MAX_ENTRIES(1).
+#define RMTINT_CH              23U
+
+// ============= Local types ===============
+
+/**
+ * State of the pulse distance decoder.
+ */
+typedef struct {
+  uint32_t u32Data;  ///< Received bits (MSB first).
+  uint8_t u8Bits;    ///< Number of received bits.
+  bool bLead;        ///< Lead space has been received.
+  bool bDone;        ///< End of frame has been received.
+} SPulseDecoder;
+
+// ================ Local function declarations =================
+static void _decode_entry(void *pvDecoder, bool bLevel, uint16_t u16Ticks);
+static void _decode_end(void *pvDecoder);
+static bool _rmt_config_tx(ERmtChannel eChannel);
+static bool _rmt_config_rx(ERmtChannel eChannel);
+static void _frame_send(uint32_t u32Data);
+static void _rmtrxloop_init();
+static void _rmtrxloop_cycle(uint64_t u64Ticks);
+
+// =================== Global constants ================
+const bool gbStartAppCpu = START_APP_CPU;
+const uint16_t gu16Tim00Divisor = TIM0_0_DIVISOR;
+const uint64_t gu64tckSchedulePeriod = (CLK_FREQ_HZ / SCHEDULE_FREQ_HZ);
+
+// ==================== Local Data ================
+static SPulseDecoder gsDecoder;
+static SRmtRxStream gsRxStream;
+static bool gbRmtReady = false; ///< The RMT RAM blocks could be allocated.
+
+// ==================== Implementation ================
+
+/**
+ * Decoder entry callback: only the spaces (signal 0) carry information.
+ */
+static void _decode_entry(void *pvDecoder, bool bLevel, uint16_t u16Ticks) {
+  SPulseDecoder *psDec = (SPulseDecoder*) pvDecoder;
+  if (bLevel || FRAME_LEAD_MAX_US < u16Ticks) {
+    return;
+  }
+  if (FRAME_LEAD_MIN_US <= u16Ticks) {
+    psDec->bLead = true;
+    psDec->u8Bits = 0;
+    psDec->u32Data = 0;
+  } else if (psDec->bLead && psDec->u8Bits < FRAME_BITS) {
+    psDec->u32Data = (psDec->u32Data << 1) | (FRAME_SPACE_THRES_US < u16Ticks);
+    ++psDec->u8Bits;
+  }
+}
+
+static void _decode_end(void *pvDecoder) {
+  ((SPulseDecoder*) pvDecoder)->bDone = true;
+}
+
+static bool _rmt_config_tx(ERmtChannel eChannel) {
+  if (!rmt_ram_alloc(eChannel, RMTTX_MEM_BLOCKS, false)) {
+    return false;
+  }
+
+  SRmtChConf rChConf = {
+    .r0 =
+    {.u8DivCnt = RMT_DIVISOR, .u4MemSize = RMTTX_MEM_BLOCKS},
+    .r1 =
+    {.bRefAlwaysOn = 1, .bRefCntRst = 1, .bMemRdRst = 1, .bIdleOutLvl = 0, .bIdleOutEn = 1, .bMemOwner = 0}
+  };
+  gpsRMT->asChConf[eChannel] = rChConf;
+  return true;
+}
+
+static bool _rmt_config_rx(ERmtChannel eChannel) {
+  if (!rmt_ram_alloc(eChannel, RMTRX_MEM_BLOCKS, true)) {
+    return false;
+  }
+
+  SRmtChConf rChConf = {
+    .r0 =
+    {.u8DivCnt = RMT_DIVISOR, .u4MemSize = RMTRX_MEM_BLOCKS, .u16IdleThres = RMTRX_IDLE_US},
+    .r1 =
+    {.bRefAlwaysOn = 1, .bRefCntRst = 1, .bMemOwner = 1,
+      .bRxFilterEn = 1, .u8RxFilterThres = RMTRX_FILTER_THRES}
+  };
+  gpsRMT->asChConf[eChannel] = rChConf;
+  return true;
+}
+
+/**
+ * Puts a frame into the RAM of the transmitter and starts TX.
+ * @param u32Data Data bits (MSB first).
+ */
+static void _frame_send(uint32_t u32Data) {
+  uint16_t u16Idx = 0;
+  *rmt_ram_addr(RMTTX_CH, RMTTX_MEM_BLOCKS, u16Idx++) =
+          (RMT_SIGNAL1 | FRAME_LEAD_MARK_US) | ((RMT_SIGNAL0 | FRAME_LEAD_SPACE_US) << 16);
+  for (int i = FRAME_BITS - 1; 0 <= i; --i) {
+    uint32_t u32Space = (u32Data & (1U << i)) ? FRAME_SPACE1_US : FRAME_SPACE0_US;
+    *rmt_ram_addr(RMTTX_CH, RMTTX_MEM_BLOCKS, u16Idx++) =
+            (RMT_SIGNAL1 | FRAME_MARK_US) | ((RMT_SIGNAL0 | u32Space) << 16);
+  }
+  // stop mark, then end of TX
+  *rmt_ram_addr(RMTTX_CH, RMTTX_MEM_BLOCKS, u16Idx) = (RMT_SIGNAL1 | FRAME_MARK_US);
+  rmt_start_tx(RMTTX_CH, true);
+}
+
+static void _rmtrxloop_init() {
+  rmt_isr_init();
+  rmt_init_controller(true, true);
+  gbRmtReady = _rmt_config_tx(RMTTX_CH) && _rmt_config_rx(RMTRX_CH);
+  if (!gbRmtReady) {
+    return;
+  }
+
+  // the transmitter drives the pin, the receiver listens to the same pin through the GPIO matrix
+  rmt_init_channel(RMTTX_CH, RMTRXLOOP_GPIO, false);
+  gpio_matrix_in(RMTRXLOOP_GPIO, rmt_in_signal(RMTRX_CH), 0);
+
+  gsRxStream = rmtrx_init_stream(RMTRX_CH, RMTRX_MEM_BLOCKS, _decode_entry, _decode_end, &gsDecoder);
+  rmtrx_register_isr(&gsRxStream);
+  rmt_isr_start(CPU_PRO, RMTINT_CH);
+}
+
+/**
+ * Sends a frame periodically, and drains the receiver in every cycle,
+ * thus the frame is decoded while it is still being received.
+ * @param u64Ticks Current time in ticks.
+ */
+static void _rmtrxloop_cycle(uint64_t u64Ticks) {
+  static uint64_t u64NextTick = 0;
+  static uint32_t u32Sent = 0x00FF10EFU;
+
+  if (!gbRmtReady) {
+    return;
+  }
+  if (u64NextTick <= u64Ticks) {
+    gsDecoder = (SPulseDecoder){.bLead = false};
+    rmtrx_start(&gsRxStream);
+    _frame_send(++u32Sent);
+
+    u64NextTick += MS2TICKS(RMTRXLOOP_PERIOD_MS);
+  }
+
+  rmtrx_drain(&gsRxStream);
+  if (gsDecoder.bDone) {
+    uart_printf(&gsUART0, "sent: %08" PRIX32 " received: %08" PRIX32 " (%" PRIu8 " bits, %" PRIu32 " entries) %s\n",
+            u32Sent, gsDecoder.u32Data, gsDecoder.u8Bits, gsRxStream.u32Entries,
+            (FRAME_BITS == gsDecoder.u8Bits && u32Sent == gsDecoder.u32Data) ? "OK" : "ERROR");
+    gsDecoder.bDone = false;
+  }
+}
+
+// ====================== Interface functions =========================
+
+void prog_init_pro_pre() {
+  gsUART0.CLKDIV.u20ClkDiv = APB_FREQ_HZ / 115200;
+
+  _rmtrxloop_init();
+}
+
+void prog_init_app() {
+}
+
+void prog_init_pro_post() {
+}
+
+void prog_cycle_app(uint64_t u64tckNow) {
+}
+
+void prog_cycle_pro(uint64_t u64tckNow) {
+  _rmtrxloop_cycle(u64tckNow);
+}
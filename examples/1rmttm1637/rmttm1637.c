@@ -118,7 +118,10 @@ static void _rmttm1637_cycle(uint64_t u64Ticks) {
         }
         gau8Tm1637Data[TM1637_COLON_POS] |= 0x80;
         gsReadyData.u64tckStart = timg_ticks(gsTimer);
-        tm1637_flush_range(&gsTm1637State, TM1637_COLON_POS, TM1637_CELLS - TM1637_COLON_POS);
+        // the changed range (from TM1637_COLON_POS to the end) is found by the driver
+        if (!tm1637_flush_auto(&gsTm1637State, TM1637_CELLS)) {
+          uart_printf(&gsUART0, "Nothing to send\n");
+        }
         break;
       default:  // remove colon/dot
         gau8Tm1637Data[TM1637_COLON_POS] &= 0x7f;
@@ -141,8 +144,7 @@ static void _rmttm1637_cycle(uint64_t u64Ticks) {
 // ====================== Interface functions =========================
 
 void prog_init_pro_pre() {
-  gsUART0.CLKDIV.u20ClkDiv = APB_FREQ_HZ / 115200;
-  gsUART0.CLKDIV.u4ClkDivFrag = 7;
+  uart_set_baudrate(&gsUART0, APB_FREQ_HZ, 115200);
   _rmttm1637_init();
 }
 
@@ -0,0 +1,126 @@
+/*
+ * Copyright 2025 SZIGETI János
+ *
+ * This file is part of Bilis ESP32 Basic, which is released under GNU General Public License.version 3.
+ * See LICENSE or <https://www.gnu.org/licenses/> for full license details.
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "tm1637.h"
+#include "tm1637anim.h"
+#include "main.h"
+#include "rmt.h"
+#include "defines.h"
+#include "timg.h"
+#include "utils/generators.h"
+#include "utils/uartutils.h"
+
+// =================== Hard constants =================
+// #1: Timings
+#define SCROLL_FRAME_MS  300U
+#define BLINK_FRAME_MS   500U
+#define SWITCH_PERIOD_MS 15000U
+
+// #2: Channels / wires / addresses
+#define CLK_GPIO         21U
+#define DIO_GPIO         19U
+#define CLK_CH           RMT_CH1
+#define DIO_CH           RMT_CH0
+
+#define RMTINT_CH        23U
+#define TIMINT_CH        24U
+
+// #3 Sizes
+#define TM1637_CELLS      4U
+
+// ================ Local function declarations =================
+static void _rmttm1637anim_init();
+static void _rmttm1637anim_cycle(uint64_t u64Ticks);
+
+// =================== Global constants ================
+const bool gbStartAppCpu = START_APP_CPU;
+const uint16_t gu16Tim00Divisor = TIM0_0_DIVISOR;
+const uint64_t gu64tckSchedulePeriod = (CLK_FREQ_HZ / SCHEDULE_FREQ_HZ);
+
+// ==================== Local Data ================
+static const TimerId gsTimer = {.eTimg = TIMG_0, .eTimer = TIMER0};
+static const char gacScrollText[] = "HELLO 23.5" TM1637ANIM_DEGREE "C  -  Bilis ESP32 Basic";
+static const char gacBlinkText[] = "Err-";
+
+static STm1637State gsTm1637State;
+static STm1637Anim gsAnim;
+static SByteGenState gsScrollGen;
+static SByteGenState gsBlinkGen;
+static bool gbRmtReady = false; ///< The RMT RAM blocks could be allocated.
+
+// ==================== Implementation ================
+
+static void _rmttm1637anim_init() {
+  rmt_isr_init();
+  rmt_init_controller(true, true);
+  STm1637Iface sIface = { CLK_GPIO, DIO_GPIO, CLK_CH, DIO_CH};
+  gsTm1637State = tm1637_config(&sIface, NULL);
+  gbRmtReady = tm1637_init(&gsTm1637State, APB_FREQ_HZ);
+  if (!gbRmtReady) {
+    return;
+  }
+  tm1637_set_brightness(&gsTm1637State, true, 7);
+  rmt_isr_start(CPU_PRO, RMTINT_CH);
+
+  gsScrollGen = bytegen_init((const uint8_t*) gacScrollText, strlen(gacScrollText));
+  gsBlinkGen = bytegen_init((const uint8_t*) gacBlinkText, strlen(gacBlinkText));
+  gsAnim = tm1637anim_init(&gsTm1637State, TM1637_CELLS, gsTimer, TIMINT_CH, MS2TICKS(SCROLL_FRAME_MS));
+}
+
+/**
+ * Switches between the scrolling and the blinking animation. The frames are computed and sent in ISR context;
+ * this function only changes the animation (after the previous one has stopped).
+ */
+static void _rmttm1637anim_cycle(uint64_t u64Ticks) {
+  static uint64_t u64NextTick = 0;
+  static bool bScroll = false;
+
+  if (!gbRmtReady) {
+    return;
+  }
+  if (u64NextTick <= u64Ticks) {
+    if (tm1637anim_is_running(&gsAnim)) {
+      tm1637anim_stop(&gsAnim);
+      return; // try again in the next cycle
+    }
+    bScroll = !bScroll;
+    uart_printf(&gsUART0, "%s (frames: %u)\n", bScroll ? "Scroll" : "Blink", gsAnim.u32Frames);
+    if (bScroll) {
+      gsAnim.u32tckFrame = MS2TICKS(SCROLL_FRAME_MS);
+      bytegen_reset(&gsScrollGen);
+      tm1637anim_start_scroll(&gsAnim, &gsScrollGen, &gsByteGenFunc, true);
+    } else {
+      gsAnim.u32tckFrame = MS2TICKS(BLINK_FRAME_MS);
+      bytegen_reset(&gsBlinkGen);
+      tm1637anim_start_blink(&gsAnim, &gsBlinkGen, &gsByteGenFunc);
+    }
+    u64NextTick = u64Ticks + MS2TICKS(SWITCH_PERIOD_MS);
+  }
+}
+
+// ====================== Interface functions =========================
+
+void prog_init_pro_pre() {
+  uart_set_baudrate(&gsUART0, APB_FREQ_HZ, 115200);
+  _rmttm1637anim_init();
+}
+
+void prog_init_app() {
+}
+
+void prog_init_pro_post() {
+}
+
+void prog_cycle_app(uint64_t u64tckNow) {
+}
+
+void prog_cycle_pro(uint64_t u64tckNow) {
+  _rmttm1637anim_cycle(u64tckNow);
+}
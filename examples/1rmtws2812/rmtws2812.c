@@ -90,6 +90,7 @@ static uint8_t gau8PreBuffer1[3 * STRIP_LENGTH];
 static uint8_t gau8Buffer[3 * STRIP_LENGTH];
 static SWs2812State gsFeederState;
 static bool gbFeederBusy = false;
+static bool gbRmtReady = false; ///< The RMT RAM blocks could be allocated.
 
 // ==================== Implementation ================
 static void _fill_prebuffer(uint8_t *pu8Dest, uint8_t u8Stop0Idx, uint8_t u8Stop1Idx) {
@@ -141,7 +142,10 @@ static void _rmtws2812_init_peripheral() {
   rmt_isr_init(); // ws2812_init will write into rmt_isr table
   rmt_init_controller(true, true);
   gsFeederState = ws2812_init_feederstate(gau8Buffer, sizeof (gau8Buffer), RMTWS2812_CH, RMTWS2812_MEM_BLOCKS);
-  ws2812_init(RMTWS2812_GPIO, APB_FREQ_HZ, &gsFeederState, _rmtws2812_txend_cb, &gbFeederBusy);
+  gbRmtReady = ws2812_init(RMTWS2812_GPIO, APB_FREQ_HZ, &gsFeederState, _rmtws2812_txend_cb, &gbFeederBusy);
+  if (!gbRmtReady) {
+    return;
+  }
 
   // enable RMT ISR
   rmt_isr_start(CPU_PRO, RMTINT_CH);
@@ -151,6 +155,9 @@ static void _rmtws2812_cycle(uint64_t u64Ticks) {
   static uint64_t u64NextTick = 0;
   static bool bFirstRun = true;
 
+  if (!gbRmtReady) {
+    return;
+  }
   if (bFirstRun) {
     gbFeederBusy = true;
     ws2812_start(&gsFeederState);
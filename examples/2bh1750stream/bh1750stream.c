@@ -0,0 +1,131 @@
+/*
+ * Copyright 2025 SZIGETI János
+ *
+ * This file is part of Bilis ESP32 Basic, which is released under GNU General Public License.version 3.
+ * See LICENSE or <https://www.gnu.org/licenses/> for full license details.
+ */
+#include <stdbool.h>
+#include <inttypes.h>
+#include <stddef.h>
+
+#include "i2c.h"
+#include "main.h"
+#include "defines.h"
+#include "lockmgr.h"
+#include "uart.h"
+#include "bh1750.h"
+#include "utils/uartutils.h"
+
+// =================== Hard constants =================
+// #1: Timings
+#define BH1750_START_MS     2000U    ///< Give time for the terminal to connect.
+#define I2C_FREQ_HZ       400000U
+
+// #2: Channels / wires / addresses
+#define I2C0_SCL_GPIO         22U
+#define I2C0_SDA_GPIO         23U
+#define BH1750_I2C_CH       I2C0
+#define BH1750_I2C_SLAVEADDR 0x23
+
+// #3: Others
+#define BH1750_MRES  BH1750_RES_H2
+#define BH1750_MTIME          69U    ///< Default MTreg value (no MTreg update is needed).
+
+// ================ Local function declarations =================
+static ELockmgrResource _i2c_to_lock(EI2CBus eBus);
+static void _i2c_release_cycle(uint64_t u64Ticks);
+static void _bh1750_sample(void *pvParam, uint32_t u32mLx);
+static void _bh1750_init();
+static void _bh1750_cycle(uint64_t u64Ticks);
+
+// =================== Global constants ================
+const bool gbStartAppCpu = START_APP_CPU;
+const uint16_t gu16Tim00Divisor = TIM0_0_DIVISOR;
+const uint64_t gu64tckSchedulePeriod = (CLK_FREQ_HZ / SCHEDULE_FREQ_HZ);
+
+// ==================== Local Data ================
+static SBh1750Stream gsBh1750Stream;
+
+// ==================== Implementation ================
+
+static ELockmgrResource _i2c_to_lock(EI2CBus eBus) {
+  return eBus;
+}
+
+/**
+ * Completes the I2C transaction in progress: copies the received bytes and frees the bus.
+ * @param u64Ticks Current time in ticks.
+ */
+static void _i2c_release_cycle(uint64_t u64Ticks) {
+  ELockmgrResource eBus = _i2c_to_lock(BH1750_I2C_CH);
+  I2C_Type *psI2C = i2c_regs(eBus);
+  RegAddr prData = i2c_nonfifo(eBus);
+
+  if (lockmgr_is_locked(eBus) && !i2c_isbusy(psI2C)) {
+    uint32_t u32Label = lockmgr_get_lock_owner(eBus);
+    AsyncResultEntry* psEntry = lockmgr_get_entry(u32Label);
+    psEntry->u32IntSt = psI2C->INT_ST;
+    for (int i = 0; i < psEntry->u8RxLen; ++i) {
+      psEntry->pu8ReceiveBuffer[i] = (uint8_t) (prData[i] & 0xff);
+    }
+    psEntry->bReady = true;
+    lockmgr_free_lock(eBus);
+  }
+}
+
+/**
+ * Sample callback of the streaming driver: invoked only if the illuminance has changed.
+ * @param pvParam Streaming driver descriptor.
+ * @param u32mLx Illuminance.
+ */
+static void _bh1750_sample(void *pvParam, uint32_t u32mLx) {
+  const SBh1750Stream *psStream = (const SBh1750Stream*) pvParam;
+  uart_printf(&gsUART0, "%" PRIu32 ".%03" PRIu32 " lx (reads: %" PRIu32 ", samples: %" PRIu32 ")\n",
+          u32mLx / 1000, u32mLx % 1000, psStream->u32Reads, psStream->u32Samples);
+}
+
+static void _bh1750_init() {
+  SI2cIfaceCfg sIface = {
+    .eBus = BH1750_I2C_CH,
+    .eLck = _i2c_to_lock(BH1750_I2C_CH),
+    .u8SlaveAddr = BH1750_I2C_SLAVEADDR
+  };
+  gsBh1750Stream = bh1750_stream_init(&sIface, BH1750_MRES, BH1750_MTIME, _bh1750_sample, &gsBh1750Stream);
+}
+
+/**
+ * Runs the streaming driver at the pace of its wait hints.
+ * The next deadline is computed from the previous one, so the reads keep the cadence of the device.
+ * @param u64Ticks Current time in ticks.
+ */
+static void _bh1750_cycle(uint64_t u64Ticks) {
+  static uint64_t u64NextTick = MS2TICKS(BH1750_START_MS);
+
+  if (u64NextTick <= u64Ticks) {
+    u64NextTick += MS2TICKS(bh1750_stream_cycle(&gsBh1750Stream)) / 2;
+  }
+}
+
+// ====================== Interface functions =========================
+
+void prog_init_pro_pre() {
+  uart_set_baudrate(&gsUART0, APB_FREQ_HZ, 115200);
+
+  lockmgr_init();
+  i2c_init_controller(BH1750_I2C_CH, I2C0_SCL_GPIO, I2C0_SDA_GPIO, HZ2APBTICKS(I2C_FREQ_HZ));
+  _bh1750_init();
+}
+
+void prog_init_app() {
+}
+
+void prog_init_pro_post() {
+}
+
+void prog_cycle_app(uint64_t u64tckNow) {
+}
+
+void prog_cycle_pro(uint64_t u64tckNow) {
+  _i2c_release_cycle(u64tckNow);
+  _bh1750_cycle(u64tckNow);
+}
@@ -0,0 +1,321 @@
+/*
+ * Copyright 2025 SZIGETI János
+ *
+ * This file is part of Bilis ESP32 Basic, which is released under GNU General Public License.version 3.
+ * See LICENSE or <https://www.gnu.org/licenses/> for full license details.
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include "typeaux.h"
+#include "bme280.h"
+#include "bench.h"
+
+// =================== Hard constants =================
+#define SAMPLES 256U  ///< Samples per repetition (different raw values).
+#define HOST_REPS 2000U
+#define TARGET_REPS 8U
+// Raw value ranges (approx. -40 .. 85 °C, 300 .. 1100 hPa, full humidity range)
+#define RAW_T_MIN 380000
+#define RAW_T_SPAN 260000
+#define RAW_P_MIN 150000
+#define RAW_P_SPAN 600000
+#define RAW_H_SPAN 65536
+
+#define LCG_SEED 0x2545f491U
+#define LCG_NEXT(X) ((X) * 1664525U + 1013904223U)
+
+// ============= Local types ===============
+
+/**
+ * Calibration values with the types of the datasheet.
+ */
+typedef struct {
+  uint16_t dig_T1;
+  int16_t dig_T2, dig_T3;
+  uint16_t dig_P1;
+  int16_t dig_P2, dig_P3, dig_P4, dig_P5, dig_P6, dig_P7, dig_P8, dig_P9;
+  uint8_t dig_H1;
+  int16_t dig_H2;
+  uint8_t dig_H3;
+  int16_t dig_H4, dig_H5;
+  int8_t dig_H6;
+} SRefCalib;
+
+/**
+ * Check case.
+ * @param psCalib Parsed calibration data.
+ * @param asRaw Raw values (temperature, pressure, humidity).
+ * @param asOut Output: compensated values.
+ */
+typedef void (*FBmeCheckCase)(const SBme280Calib *psCalib, const SBme280TPH *asRaw, SBme280TPH *asOut);
+
+/**
+ * Reference of a check case.
+ * @param psRef Calibration data.
+ * @param psRaw Raw values.
+ * @param psOut Compensated values to check.
+ * @return The compensated values match the reference formula.
+ */
+typedef bool (*FBmeCheckRef)(const SRefCalib *psRef, const SBme280TPH *psRaw, const SBme280TPH *psOut);
+
+typedef struct {
+  const char *pcName;
+  FBmeCheckCase fCase;
+  FBmeCheckRef fRef;
+} SBmeCheckCase;
+
+// ================ Local function declarations =================
+static void _encode_calib(const SRefCalib *psRef, uint8_t *pu8Calib);
+static void _encode_data(const SBme280TPH *psRaw, uint8_t *pu8Data);
+static int32_t _ref_T(const SRefCalib *psRef, int32_t adc_T, int32_t *t_fine);
+static uint32_t _ref_P64(const SRefCalib *psRef, int32_t adc_P, int32_t t_fine);
+static uint32_t _ref_P32(const SRefCalib *psRef, int32_t adc_P, int32_t t_fine);
+static uint32_t _ref_H(const SRefCalib *psRef, int32_t adc_H, int32_t t_fine);
+static void _case_raw(const SBme280Calib *psCalib, const SBme280TPH *asRaw, SBme280TPH *asOut);
+static void _case_cached(const SBme280Calib *psCalib, const SBme280TPH *asRaw, SBme280TPH *asOut);
+static void _case_p64(const SBme280Calib *psCalib, const SBme280TPH *asRaw, SBme280TPH *asOut);
+static void _case_p32(const SBme280Calib *psCalib, const SBme280TPH *asRaw, SBme280TPH *asOut);
+static bool _check_tph(const SRefCalib *psRef, const SBme280TPH *psRaw, const SBme280TPH *psOut);
+static bool _check_p64(const SRefCalib *psRef, const SBme280TPH *psRaw, const SBme280TPH *psOut);
+static bool _check_p32(const SRefCalib *psRef, const SBme280TPH *psRaw, const SBme280TPH *psOut);
+static void _run(const void *pvCase, uint32_t u32Reps, SBenchResult *psRes);
+
+// =================== Global constants ================
+
+/**
+ * Calibration sets: the example values of the Bosch driver and a real device.
+ */
+static const SRefCalib gasRefCalib[] = {
+  {27504, 26435, -1000, 36477, -10685, 3024, 2855, 140, -7, 15500, -14600, 6000, 75, 362, 0, 313, 50, 30},
+  {28485, 26735, 50, 36864, -10483, 3024, 6628, -25, -7, 9900, -10230, 4285, 75, 351, 0, 347, 0, 30},
+};
+
+static const SBmeCheckCase gasCases[] = {
+  {"tph_raw", _case_raw, _check_tph},
+  {"tph_cached", _case_cached, _check_tph},
+  {"pres_p64", _case_p64, _check_p64},
+  {"pres_p32", _case_p32, _check_p32},
+};
+
+// ==================== Local Data ================
+static SBme280TPH gasRaw[SAMPLES];
+static SBme280TPH gasOut[SAMPLES];
+static uint8_t gau8Calib[42];
+
+// ==================== Implementation ================
+
+/**
+ * Encodes calibration values into the register layout of the device (mem 0x88 .. 0xa1, 0xe1 .. 0xf0).
+ */
+static void _encode_calib(const SRefCalib *psRef, uint8_t *pu8Calib) {
+  const uint16_t au16Words[] = {
+    psRef->dig_T1, psRef->dig_T2, psRef->dig_T3,
+    psRef->dig_P1, psRef->dig_P2, psRef->dig_P3, psRef->dig_P4, psRef->dig_P5,
+    psRef->dig_P6, psRef->dig_P7, psRef->dig_P8, psRef->dig_P9
+  };
+  for (int i = 0; i < ARRAY_SIZE(au16Words); ++i) {
+    pu8Calib[2 * i] = au16Words[i] & 0xff;
+    pu8Calib[2 * i + 1] = au16Words[i] >> 8;
+  }
+  pu8Calib[24] = 0;
+  pu8Calib[25] = psRef->dig_H1;
+  pu8Calib[26] = psRef->dig_H2 & 0xff;
+  pu8Calib[27] = (uint16_t) psRef->dig_H2 >> 8;
+  pu8Calib[28] = psRef->dig_H3;
+  pu8Calib[29] = (psRef->dig_H4 >> 4) & 0xff;
+  pu8Calib[30] = (psRef->dig_H4 & 0x0f) | ((psRef->dig_H5 & 0x0f) << 4);
+  pu8Calib[31] = (psRef->dig_H5 >> 4) & 0xff;
+  pu8Calib[32] = psRef->dig_H6;
+}
+
+/**
+ * Encodes raw values into the data register layout (mem 0xf7 .. 0xfe).
+ */
+static void _encode_data(const SBme280TPH *psRaw, uint8_t *pu8Data) {
+  pu8Data[0] = psRaw->i32Pres >> 12;
+  pu8Data[1] = psRaw->i32Pres >> 4;
+  pu8Data[2] = psRaw->i32Pres << 4;
+  pu8Data[3] = psRaw->i32Temp >> 12;
+  pu8Data[4] = psRaw->i32Temp >> 4;
+  pu8Data[5] = psRaw->i32Temp << 4;
+  pu8Data[6] = psRaw->i32Hum >> 8;
+  pu8Data[7] = psRaw->i32Hum;
+}
+
+// Reference formulas of the datasheet (BST-BME280-DS002, 4.2.3 and 8.2)
+
+static int32_t _ref_T(const SRefCalib *psRef, int32_t adc_T, int32_t *t_fine) {
+  int32_t var1, var2;
+  var1 = ((((adc_T >> 3) - ((int32_t) psRef->dig_T1 << 1))) * ((int32_t) psRef->dig_T2)) >> 11;
+  var2 = (((((adc_T >> 4) - ((int32_t) psRef->dig_T1)) * ((adc_T >> 4) - ((int32_t) psRef->dig_T1))) >> 12) *
+          ((int32_t) psRef->dig_T3)) >> 14;
+  *t_fine = var1 + var2;
+  return (*t_fine * 5 + 128) >> 8;
+}
+
+static uint32_t _ref_P64(const SRefCalib *psRef, int32_t adc_P, int32_t t_fine) {
+  int64_t var1, var2, p;
+  var1 = ((int64_t) t_fine) - 128000;
+  var2 = var1 * var1 * (int64_t) psRef->dig_P6;
+  var2 = var2 + ((var1 * (int64_t) psRef->dig_P5) << 17);
+  var2 = var2 + (((int64_t) psRef->dig_P4) << 35);
+  var1 = ((var1 * var1 * (int64_t) psRef->dig_P3) >> 8) + ((var1 * (int64_t) psRef->dig_P2) << 12);
+  var1 = (((((int64_t) 1) << 47) + var1)) * ((int64_t) psRef->dig_P1) >> 33;
+  if (var1 == 0) {
+    return 0;
+  }
+  p = 1048576 - adc_P;
+  p = (((p << 31) - var2) * 3125) / var1;
+  var1 = (((int64_t) psRef->dig_P9) * (p >> 13) * (p >> 13)) >> 25;
+  var2 = (((int64_t) psRef->dig_P8) * p) >> 19;
+  p = ((p + var1 + var2) >> 8) + (((int64_t) psRef->dig_P7) << 4);
+  return (uint32_t) p;
+}
+
+static uint32_t _ref_P32(const SRefCalib *psRef, int32_t adc_P, int32_t t_fine) {
+  int32_t var1, var2;
+  uint32_t p;
+  var1 = (((int32_t) t_fine) >> 1) - (int32_t) 64000;
+  var2 = (((var1 >> 2) * (var1 >> 2)) >> 11) * ((int32_t) psRef->dig_P6);
+  var2 = var2 + ((var1 * ((int32_t) psRef->dig_P5)) << 1);
+  var2 = (var2 >> 2)+(((int32_t) psRef->dig_P4) << 16);
+  var1 = (((psRef->dig_P3 * (((var1 >> 2) * (var1 >> 2)) >> 13)) >> 3) + ((((int32_t) psRef->dig_P2) * var1) >> 1)) >> 18;
+  var1 = ((((32768 + var1))*((int32_t) psRef->dig_P1)) >> 15);
+  if (var1 == 0) {
+    return 0;
+  }
+  p = (((uint32_t) (((int32_t) 1048576) - adc_P)-(var2 >> 12)))*3125;
+  if (p < 0x80000000) {
+    p = (p << 1) / ((uint32_t) var1);
+  } else {
+    p = (p / (uint32_t) var1) * 2;
+  }
+  var1 = (((int32_t) psRef->dig_P9) * ((int32_t) (((p >> 3) * (p >> 3)) >> 13))) >> 12;
+  var2 = (((int32_t) (p >> 2)) * ((int32_t) psRef->dig_P8)) >> 13;
+  p = (uint32_t) ((int32_t) p + ((var1 + var2 + psRef->dig_P7) >> 4));
+  return p;
+}
+
+static uint32_t _ref_H(const SRefCalib *psRef, int32_t adc_H, int32_t t_fine) {
+  int32_t v_x1_u32r;
+  v_x1_u32r = (t_fine - ((int32_t) 76800));
+  v_x1_u32r = (((((adc_H << 14) - (((int32_t) psRef->dig_H4) << 20) - (((int32_t) psRef->dig_H5) * v_x1_u32r)) +
+          ((int32_t) 16384)) >> 15) * (((((((v_x1_u32r * ((int32_t) psRef->dig_H6)) >> 10) * (((v_x1_u32r *
+          ((int32_t) psRef->dig_H3)) >> 11) + ((int32_t) 32768))) >> 10) + ((int32_t) 2097152)) *
+          ((int32_t) psRef->dig_H2) + 8192) >> 14));
+  v_x1_u32r = (v_x1_u32r - (((((v_x1_u32r >> 15) * (v_x1_u32r >> 15)) >> 7) * ((int32_t) psRef->dig_H1)) >> 4));
+  v_x1_u32r = (v_x1_u32r < 0 ? 0 : v_x1_u32r);
+  v_x1_u32r = (v_x1_u32r > 419430400 ? 419430400 : v_x1_u32r);
+  return (uint32_t) (v_x1_u32r >> 12);
+}
+
+// Cases
+
+static void _case_raw(const SBme280Calib *psCalib, const SBme280TPH *asRaw, SBme280TPH *asOut) {
+  uint8_t au8Data[8];
+  for (int i = 0; i < SAMPLES; ++i) {
+    _encode_data(&asRaw[i], au8Data);
+    asOut[i] = bme280_calc_measeurement(au8Data, gau8Calib, NULL);
+  }
+}
+
+static void _case_cached(const SBme280Calib *psCalib, const SBme280TPH *asRaw, SBme280TPH *asOut) {
+  uint8_t au8Data[8];
+  for (int i = 0; i < SAMPLES; ++i) {
+    _encode_data(&asRaw[i], au8Data);
+    asOut[i] = bme280_calc_measurement_cached(au8Data, psCalib, NULL);
+  }
+}
+
+static void _case_p64(const SBme280Calib *psCalib, const SBme280TPH *asRaw, SBme280TPH *asOut) {
+  for (int i = 0; i < SAMPLES; ++i) {
+    // the raw temperature field carries t_fine
+    asOut[i].i32Pres = bme280_compensate_p64(asRaw[i].i32Pres, psCalib, asRaw[i].i32Temp);
+  }
+}
+
+static void _case_p32(const SBme280Calib *psCalib, const SBme280TPH *asRaw, SBme280TPH *asOut) {
+  for (int i = 0; i < SAMPLES; ++i) {
+    asOut[i].i32Pres = bme280_compensate_p32(asRaw[i].i32Pres, psCalib, asRaw[i].i32Temp);
+  }
+}
+
+// References
+
+static bool _check_tph(const SRefCalib *psRef, const SBme280TPH *psRaw, const SBme280TPH *psOut) {
+  int32_t t_fine;
+  int32_t i32T = _ref_T(psRef, psRaw->i32Temp, &t_fine);
+  return psOut->i32Temp == i32T
+          && (uint32_t) psOut->i32Pres == _ref_P64(psRef, psRaw->i32Pres, t_fine)
+          && (uint32_t) psOut->i32Hum == _ref_H(psRef, psRaw->i32Hum, t_fine);
+}
+
+static bool _check_p64(const SRefCalib *psRef, const SBme280TPH *psRaw, const SBme280TPH *psOut) {
+  return (uint32_t) psOut->i32Pres == _ref_P64(psRef, psRaw->i32Pres, psRaw->i32Temp);
+}
+
+static bool _check_p32(const SRefCalib *psRef, const SBme280TPH *psRaw, const SBme280TPH *psOut) {
+  return (uint32_t) psOut->i32Pres == _ref_P32(psRef, psRaw->i32Pres, psRaw->i32Temp) << 8;
+}
+
+/**
+ * The extra value of the result is the max. difference from the 64-bit reference pressure (in mPa).
+ */
+static void _run(const void *pvCase, uint32_t u32Reps, SBenchResult *psRes) {
+  const SBmeCheckCase *psCase = (const SBmeCheckCase*) pvCase;
+  uint32_t u32MaxPresDiff = 0; // 1/256 Pa
+  bool bTFine = (_check_tph != psCase->fRef); // pressure-only cases take t_fine instead of raw temperature
+  uint32_t u32Seed = LCG_SEED;
+
+  for (uint32_t r = 0; r < u32Reps; ++r) {
+    const SRefCalib *psRef = &gasRefCalib[r % ARRAY_SIZE(gasRefCalib)];
+    _encode_calib(psRef, gau8Calib);
+    SBme280Calib sCalib = bme280_parse_calib(gau8Calib);
+    for (int i = 0; i < SAMPLES; ++i) {
+      u32Seed = LCG_NEXT(u32Seed);
+      int32_t i32T = RAW_T_MIN + (u32Seed >> 8) % RAW_T_SPAN;
+      if (bTFine) {
+        _ref_T(psRef, i32T, &i32T);
+      }
+      u32Seed = LCG_NEXT(u32Seed);
+      int32_t i32P = RAW_P_MIN + (u32Seed >> 8) % RAW_P_SPAN;
+      u32Seed = LCG_NEXT(u32Seed);
+      gasRaw[i] = (SBme280TPH){i32T, i32P, (u32Seed >> 8) % RAW_H_SPAN};
+    }
+
+    uint32_t u32Start = bench_now();
+    psCase->fCase(&sCalib, gasRaw, gasOut);
+    psRes->u32Elapsed += bench_now() - u32Start;
+
+    for (int i = 0; i < SAMPLES; ++i) {
+      if (!psCase->fRef(psRef, &gasRaw[i], &gasOut[i])) {
+        ++psRes->u32Mismatches;
+      }
+      int32_t t_fine = gasRaw[i].i32Temp;
+      if (!bTFine) {
+        _ref_T(psRef, gasRaw[i].i32Temp, &t_fine);
+      }
+      int32_t i32Diff = (int32_t) (gasOut[i].i32Pres - _ref_P64(psRef, gasRaw[i].i32Pres, t_fine));
+      uint32_t u32Diff = (i32Diff < 0) ? -i32Diff : i32Diff;
+      if (u32MaxPresDiff < u32Diff) {
+        u32MaxPresDiff = u32Diff;
+      }
+    }
+    psRes->u32Items += SAMPLES;
+  }
+  psRes->u32Extra = u32MaxPresDiff * 1000U / 256U;
+}
+
+// ====================== Interface functions =========================
+
+const SBenchSuite gsBenchSuite = {
+  BENCH_CASES(gasCases),
+  .fRun = _run,
+  .pcItem = "sample",
+  .pcExtraUnit = "mPa",
+  .bChecksum = false,
+  .u32HostReps = HOST_REPS,
+  .u32TargetReps = TARGET_REPS
+};
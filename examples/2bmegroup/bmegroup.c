@@ -0,0 +1,151 @@
+/*
+ * Copyright 2025 SZIGETI János
+ *
+ * This file is part of Bilis ESP32 Basic, which is released under GNU General Public License.version 3.
+ * See LICENSE or <https://www.gnu.org/licenses/> for full license details.
+ */
+#include <stdbool.h>
+#include <inttypes.h>
+#include <stddef.h>
+
+#include "i2c.h"
+#include "main.h"
+#include "defines.h"
+#include "lockmgr.h"
+#include "typeaux.h"
+#include "uart.h"
+#include "bme280.h"
+#include "utils/uartutils.h"
+
+// =================== Hard constants =================
+// #1: Timings
+#define BME280_START_MS     2000U    ///< Give time for the terminal to connect.
+#define BME280_PERIOD_MS    1000U    ///< A round (one sample of each device) is started in every second.
+#define I2C_FREQ_HZ       400000U
+
+// #2: Channels / wires / addresses
+#define I2C0_SCL_GPIO         22U
+#define I2C0_SDA_GPIO         23U
+#define BME280_I2C_CH       I2C0
+
+// #3: Others
+#define BME280_FILTER BME280_IIR_OFF
+
+// ================ Local function declarations =================
+static ELockmgrResource _i2c_to_lock(EI2CBus eBus);
+static void _i2c_release_cycle(uint64_t u64Ticks);
+static void _bme280_sample(void *pvParam, uint8_t u8Member, const SBme280TPH *psRes, uint32_t u32TFine);
+static void _bme280_init();
+static void _bme280_cycle(uint64_t u64Ticks);
+
+// =================== Global constants ================
+const bool gbStartAppCpu = START_APP_CPU;
+const uint16_t gu16Tim00Divisor = TIM0_0_DIVISOR;
+const uint64_t gu64tckSchedulePeriod = (CLK_FREQ_HZ / SCHEDULE_FREQ_HZ);
+const uint8_t gau8Bme280Addr[] = {0x76, 0x77}; ///< Both devices are on the same bus.
+
+// ==================== Local Data ================
+static SBme280Group gsBme280Group;
+static uint8_t gu8Bme280Pending; ///< Members (bit index) that have not delivered a sample in the current round.
+
+// ==================== Implementation ================
+
+static ELockmgrResource _i2c_to_lock(EI2CBus eBus) {
+  return eBus;
+}
+
+/**
+ * Completes the I2C transaction in progress: copies the received bytes and frees the bus.
+ * @param u64Ticks Current time in ticks.
+ */
+static void _i2c_release_cycle(uint64_t u64Ticks) {
+  ELockmgrResource eBus = _i2c_to_lock(BME280_I2C_CH);
+  I2C_Type *psI2C = i2c_regs(eBus);
+  RegAddr prData = i2c_nonfifo(eBus);
+
+  if (lockmgr_is_locked(eBus) && !i2c_isbusy(psI2C)) {
+    uint32_t u32Label = lockmgr_get_lock_owner(eBus);
+    AsyncResultEntry* psEntry = lockmgr_get_entry(u32Label);
+    psEntry->u32IntSt = psI2C->INT_ST;
+    for (int i = 0; i < psEntry->u8RxLen; ++i) {
+      psEntry->pu8ReceiveBuffer[i] = (uint8_t) (prData[i] & 0xff);
+    }
+    psEntry->bReady = true;
+    lockmgr_free_lock(eBus);
+  }
+}
+
+/**
+ * Sample callback of the BME280 group.
+ * @param pvParam Unused.
+ * @param u8Member Index of the device.
+ * @param psRes Compensated sample.
+ * @param u32TFine t_fine value.
+ */
+static void _bme280_sample(void *pvParam, uint8_t u8Member, const SBme280TPH *psRes, uint32_t u32TFine) {
+  gu8Bme280Pending &= ~(1 << u8Member);
+  uart_printf(&gsUART0, "#%u (0x%02X) T: %" PRIi32 " cC, P: %" PRIi32 " Pa, RH: %" PRIi32 " %%\n",
+          u8Member, gau8Bme280Addr[u8Member], psRes->i32Temp, psRes->i32Pres >> 8, psRes->i32Hum >> 10);
+}
+
+static void _bme280_init() {
+  SI2cIfaceCfg asIface[ARRAY_SIZE(gau8Bme280Addr)];
+  for (uint8_t i = 0; i < ARRAY_SIZE(gau8Bme280Addr); ++i) {
+    asIface[i] = (SI2cIfaceCfg){
+      .eBus = BME280_I2C_CH,
+      .eLck = _i2c_to_lock(BME280_I2C_CH),
+      .u8SlaveAddr = gau8Bme280Addr[i]
+    };
+  }
+  bme280_group_init(&gsBme280Group, asIface, ARRAY_SIZE(gau8Bme280Addr),
+          BME280_OSRS_8, BME280_OSRS_8, BME280_OSRS_8, BME280_FILTER, _bme280_sample, NULL);
+}
+
+/**
+ * Runs the group cycles of a round at the pace of the wait hints, then waits for the next round.
+ * A round is over when every device has delivered a sample, or when the period has elapsed
+ * (a missing device is reported).
+ * @param u64Ticks Current time in ticks.
+ */
+static void _bme280_cycle(uint64_t u64Ticks) {
+  static uint64_t u64NextTick = MS2TICKS(BME280_START_MS);
+  static uint64_t u64RoundEnd = MS2TICKS(BME280_START_MS);
+
+  if (u64NextTick <= u64Ticks) {
+    if (u64RoundEnd <= u64Ticks) {
+      for (uint8_t i = 0; i < gsBme280Group.u8Count; ++i) {
+        if (gu8Bme280Pending & (1 << i)) {
+          uart_printf(&gsUART0, "#%u (0x%02X) no sample\n", i, gau8Bme280Addr[i]);
+        }
+      }
+      gu8Bme280Pending = (1 << gsBme280Group.u8Count) - 1;
+      u64RoundEnd = u64Ticks + MS2TICKS(BME280_PERIOD_MS);
+    }
+    uint32_t u32hmsWaitHint = bme280_group_cycle(&gsBme280Group, (uint32_t) (u64Ticks / (TICKS_PER_MS / 2)));
+    u64NextTick = (0 == gu8Bme280Pending) ? u64RoundEnd : u64Ticks + MS2TICKS(u32hmsWaitHint) / 2;
+  }
+}
+
+// ====================== Interface functions =========================
+
+void prog_init_pro_pre() {
+  gsUART0.CLKDIV.u20ClkDiv = APB_FREQ_HZ / 115200;
+
+  lockmgr_init();
+  i2c_init_controller(BME280_I2C_CH, I2C0_SCL_GPIO, I2C0_SDA_GPIO, HZ2APBTICKS(I2C_FREQ_HZ));
+  _bme280_init();
+}
+
+void prog_init_app() {
+}
+
+void prog_init_pro_post() {
+}
+
+void prog_cycle_app(uint64_t u64tckNow) {
+}
+
+void prog_cycle_pro(uint64_t u64tckNow) {
+  _i2c_release_cycle(u64tckNow);
+  _bme280_cycle(u64tckNow);
+}
@@ -0,0 +1,132 @@
+/*
+ * Copyright 2025 SZIGETI János
+ *
+ * This file is part of Bilis ESP32 Basic, which is released under GNU General Public License.version 3.
+ * See LICENSE or <https://www.gnu.org/licenses/> for full license details.
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "typeaux.h"
+#include "ssd1306text.h"
+#include "bench.h"
+
+// =================== Hard constants =================
+#define SHIFTED_Y_OFFSET 3U ///< Row offset of the non page-aligned case.
+#define HOST_REPS 20000U
+#define TARGET_REPS 100U
+
+// ============= Local types ===============
+
+/**
+ * Renders a screen.
+ * @param psState Framebuffer to render into.
+ * @param apcLines Text lines (one per page).
+ * @param u8YOffset Row offset of the lines.
+ */
+typedef void (*FFontBenchCase)(SSsd1306StateDesc *psState, const char * const *apcLines, uint8_t u8YOffset);
+
+typedef struct {
+  const char *pcName;
+  FFontBenchCase fCase;
+  uint8_t u8YOffset;
+  bool bSameText; ///< The same screen is rendered again and again (nothing changes after the first one).
+} SFontBenchCase;
+
+// ================ Local function declarations =================
+static void _case_text(SSsd1306StateDesc *psState, const char * const *apcLines, uint8_t u8YOffset);
+static void _case_pixel(SSsd1306StateDesc *psState, const char * const *apcLines, uint8_t u8YOffset);
+static void _run(const void *pvCase, uint32_t u32Reps, SBenchResult *psRes);
+
+// =================== Global constants ================
+
+/**
+ * Two status screens, rendered alternately (21 characters per line).
+ */
+static const char * const gaapcScreens[][SSD1306_PAGES] = {
+  {
+    "T: 23.45" SSD1306TEXT_DEGREE "C  H: 45.20%",
+    "P: 1013.25 hPa   [ok]",
+    "L: 1234.5 lx   #00042",
+    "up 01:23:45  err: 0/3"
+  },
+  {
+    "T: -4.07" SSD1306TEXT_DEGREE "C  H: 91.75%",
+    "P:  987.60 hPa   {lo}",
+    "L:    0.5 lx   #00043",
+    "up 01:23:46  err: 1/3"
+  },
+};
+
+static const SFontBenchCase gasCases[] = {
+  {"text_aligned", _case_text, 0, false},
+  {"text_shifted", _case_text, SHIFTED_Y_OFFSET, false},
+  {"text_same", _case_text, 0, true},
+  {"pixel_ref", _case_pixel, 0, false},
+};
+
+// ==================== Local Data ================
+static SSsd1306StateDesc gsState;
+static SSsd1306StateDesc gsRef;
+
+// ==================== Implementation ================
+
+static void _case_text(SSsd1306StateDesc *psState, const char * const *apcLines, uint8_t u8YOffset) {
+  for (uint8_t i = 0; i < SSD1306_PAGES; ++i) {
+    ssd1306_draw_text(psState, 0, 8 * i + u8YOffset, apcLines[i]);
+  }
+}
+
+/**
+ * Reference renderer: every pixel of the glyph cells is set one by one.
+ */
+static void _case_pixel(SSsd1306StateDesc *psState, const char * const *apcLines, uint8_t u8YOffset) {
+  for (uint8_t i = 0; i < SSD1306_PAGES; ++i) {
+    uint8_t u8Y = 8 * i + u8YOffset;
+    uint8_t u8X = 0;
+    for (const char *pc = apcLines[i]; *pc && u8X < SSD1306_WIDTH; ++pc, u8X += SSD1306TEXT_ADVANCE) {
+      const uint8_t *pu8Glyph = ssd1306_glyph(*pc);
+      for (uint8_t c = 0; c < SSD1306TEXT_ADVANCE; ++c) {
+        for (uint8_t r = 0; r < SSD1306TEXT_HEIGHT; ++r) {
+          ssd1306_set_pixel(psState, u8X + c, u8Y + r, pu8Glyph[c] & (1 << r));
+        }
+      }
+    }
+  }
+}
+
+static void _run(const void *pvCase, uint32_t u32Reps, SBenchResult *psRes) {
+  const SFontBenchCase *psCase = (const SFontBenchCase*) pvCase;
+
+  gsState = ssd1306_init_state();
+  gsRef = ssd1306_init_state();
+  for (uint32_t r = 0; r < u32Reps; ++r) {
+    const char * const *apcLines = gaapcScreens[psCase->bSameText ? 0 : r % ARRAY_SIZE(gaapcScreens)];
+
+    uint32_t u32Start = bench_now();
+    psCase->fCase(&gsState, apcLines, psCase->u8YOffset);
+    psRes->u32Elapsed += bench_now() - u32Start;
+
+    _case_pixel(&gsRef, apcLines, psCase->u8YOffset);
+    if (0 != memcmp(gsState.au8Fb, gsRef.au8Fb, sizeof (gsState.au8Fb))) {
+      ++psRes->u32Mismatches;
+    }
+    for (uint8_t i = 0; i < SSD1306_PAGES; ++i) {
+      psRes->u32Items += strlen(apcLines[i]);
+    }
+  }
+}
+
+// ====================== Interface functions =========================
+
+const SBenchSuite gsBenchSuite = {
+  BENCH_CASES(gasCases),
+  .fRun = _run,
+  .pcItem = "glyph",
+  .pcExtraUnit = NULL,
+  .bChecksum = false,
+  .u32HostReps = HOST_REPS,
+  .u32TargetReps = TARGET_REPS
+};
@@ -0,0 +1,27 @@
+/*
+ * Copyright 2025 SZIGETI János
+ *
+ * This file is part of Bilis ESP32 Basic, which is released under GNU General Public License.version 3.
+ * See LICENSE or <https://www.gnu.org/licenses/> for full license details.
+ */
+#include <stddef.h>
+
+#include "i2c.h"
+#include "lockmgr.h"
+
+// ==================== Implementation ================
+// stand-ins for the I2C communication of the ssd1306 module (not used by the rendering functions, main() is in bench_host.c)
+
+void i2c_write(EI2CBus eBus, uint8_t u8Addr, uint8_t u8Len, const uint8_t *pu8Dat) {
+}
+
+bool lockmgr_acquire_lock(ELockmgrResource eBus, uint32_t *pu32Label) {
+  return false;
+}
+
+AsyncResultEntry *lockmgr_get_entry(uint32_t u32Label) {
+  return NULL;
+}
+
+void lockmgr_release_entry(uint32_t u32Label) {
+}
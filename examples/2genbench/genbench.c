@@ -0,0 +1,410 @@
+/*
+ * Copyright 2025 SZIGETI János
+ *
+ * This file is part of Bilis ESP32 Basic, which is released under GNU General Public License.version 3.
+ * See LICENSE or <https://www.gnu.org/licenses/> for full license details.
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include "typeaux.h"
+#include "rmt.h"
+#include "mphgen.h"
+#include "bench.h"
+#include "utils/generators.h"
+#include "utils/genpipe.h"
+#include "utils/rmtutils.h"
+
+// =================== Hard constants =================
+// WS2812-like PWM encoding (in RMT ticks)
+#define BIT_HI_LEN    32U
+#define BIT_LO_LEN    16U
+#define PWM_PERIOD    50U
+// Stretch ratio (long periods are split)
+#define STRETCH_MUL   5000U
+#define STRETCH_DIV      3U
+// Input sizes
+#define FRAME_LEN       48U   ///< 16 RGB LEDs
+#define FILL_LEN        32U   ///< Half RMT RAM block (entry pairs)
+#define MESSAGE "Hello, World! PARIS 0123456789 "
+// Repetitions
+#define HOST_REPS    20000U
+#define TARGET_REPS     20U
+
+#define CHECKSUM(S, V) ((S) * 31U + (V))
+
+// ============= Local types ===============
+
+/**
+ * Benchmark case.
+ * The checksum is computed over the 16-bit output values (entries), also in the fill cases,
+ * so the fill functions are validated by the checksum of the corresponding next case.
+ * @param u32Reps Number of repetitions.
+ * @param pu32Sum Output: checksum.
+ * @return Number of output values generated.
+ */
+typedef uint32_t(*FGenBenchCase)(uint32_t u32Reps, uint32_t *pu32Sum);
+
+typedef struct {
+  const char *pcName;
+  FGenBenchCase fCase;
+} SGenBenchCase;
+
+// ================ Local function declarations =================
+static const uint8_t *_frame();
+static uint32_t _sum_pairs(uint32_t u32Sum, const uint32_t *pu32Pairs, uint32_t u32Len, uint32_t *pu32Out);
+static void _run(const void *pvCase, uint32_t u32Reps, SBenchResult *psRes);
+static SBitPwmGenState _bitpwmgen_init();
+static uint32_t _bench_bytegen(uint32_t u32Reps, uint32_t *pu32Sum);
+static uint32_t _bench_bitgen(uint32_t u32Reps, uint32_t *pu32Sum);
+static uint32_t _bench_trbytegen(uint32_t u32Reps, uint32_t *pu32Sum);
+static uint32_t _bench_pwmgen(uint32_t u32Reps, uint32_t *pu32Sum);
+static uint32_t _bench_pwmgen_fill(uint32_t u32Reps, uint32_t *pu32Sum);
+static uint32_t _bench_bitpwmgen(uint32_t u32Reps, uint32_t *pu32Sum);
+static uint32_t _bench_bitpwmgen_fill(uint32_t u32Reps, uint32_t *pu32Sum);
+static uint32_t _bench_genpipe_bit_fill(uint32_t u32Reps, uint32_t *pu32Sum);
+static uint32_t _bench_genpipe_fill(uint32_t u32Reps, uint32_t *pu32Sum);
+static uint32_t _bench_stretchgen_fill(uint32_t u32Reps, uint32_t *pu32Sum);
+static uint32_t _bench_rlstretchgen_fill(uint32_t u32Reps, uint32_t *pu32Sum);
+static uint32_t _bench_genpipe_stretch_fill(uint32_t u32Reps, uint32_t *pu32Sum);
+static uint32_t _bench_mphgen(uint32_t u32Reps, uint32_t *pu32Sum);
+
+// ==================== Local Data ================
+GENPIPE_BYTE_SOURCE(gbsrc)
+GENPIPE_BIT_STAGE(gbbit, gbsrc)
+GENPIPE_PWM_STAGE(gbpwm, gbbit)
+GENPIPE_WORD_FILL(gbpwm)
+GENPIPE_BYTE_FILL(gbbit)
+GENPIPE_STRETCH_STAGE(gbstretch, gbpwm)
+GENPIPE_WORD_FILL(gbstretch)
+GENPIPE_WORD_FUNCTIONS(gbstretch, gsGbStretchFunc)
+
+static const SGenBenchCase gasCases[] = {
+  {"bytegen_next", _bench_bytegen},
+  {"bitgen_next", _bench_bitgen},
+  {"trbytegen_next", _bench_trbytegen},
+  {"pwmgen_next", _bench_pwmgen},
+  {"pwmgen_fill", _bench_pwmgen_fill},
+  {"bitpwmgen_next", _bench_bitpwmgen},
+  {"bitpwmgen_fill", _bench_bitpwmgen_fill},
+  {"genpipe_bit_fill", _bench_genpipe_bit_fill},
+  {"genpipe_fill", _bench_genpipe_fill},
+  {"stretchgen_fill", _bench_stretchgen_fill},
+  {"rlstretchgen_fill", _bench_rlstretchgen_fill},
+  {"genpipe_stretch_fill", _bench_genpipe_stretch_fill},
+  {"mphgen_next", _bench_mphgen},
+};
+
+static const char gacMessage[] = MESSAGE;
+
+// ==================== Implementation ================
+
+/**
+ * Pseudo-random input frame (the same on every platform).
+ * @return Address of the frame (FRAME_LEN bytes).
+ */
+static const uint8_t *_frame() {
+  static uint8_t au8Frame[FRAME_LEN];
+  static bool bInit = false;
+  if (!bInit) {
+    uint32_t u32Seed = 12345U;
+    for (int i = 0; i < FRAME_LEN; ++i) {
+      u32Seed = u32Seed * 1103515245U + 12345U;
+      au8Frame[i] = u32Seed >> 16;
+    }
+    bInit = true;
+  }
+  return au8Frame;
+}
+
+/**
+ * Adds the entries of entry pairs to the checksum (in the order of generation).
+ * The 0 second entry of the last pair at the end of sequence (see FToWordFill) is not an output value.
+ * @param u32Sum Checksum.
+ * @param pu32Pairs Entry pairs.
+ * @param u32Len Number of entry pairs.
+ * @param pu32Out Input/output: number of output values.
+ * @return Updated checksum.
+ */
+static uint32_t _sum_pairs(uint32_t u32Sum, const uint32_t *pu32Pairs, uint32_t u32Len, uint32_t *pu32Out) {
+  for (uint32_t i = 0; i < u32Len; ++i) {
+    u32Sum = CHECKSUM(u32Sum, pu32Pairs[i] & 0xFFFFU);
+    ++*pu32Out;
+    if (pu32Pairs[i] >> 16) {
+      u32Sum = CHECKSUM(u32Sum, pu32Pairs[i] >> 16);
+      ++*pu32Out;
+    }
+  }
+  return u32Sum;
+}
+
+/**
+ * WS2812-like bit sequence to PWM generator over the input frame.
+ * @return Initialized state descriptor.
+ */
+static SBitPwmGenState _bitpwmgen_init() {
+  SBitPwmGenState sRet = {
+    .sByteGenState = bytegen_init(_frame(), FRAME_LEN),
+    .sBitGenState = bitgen_init(0, false, BIT_HI_LEN, BIT_LO_LEN),
+    .sPwmXGenState = {.u8PeriodLen = PWM_PERIOD, .u8HiUpper = 0x80, .u8LoUpper = 0x00}
+  };
+  bitpwmgen_reset(&sRet);
+  return sRet;
+}
+
+static uint32_t _bench_bytegen(uint32_t u32Reps, uint32_t *pu32Sum) {
+  uint32_t u32Out = 0;
+  uint32_t u32Sum = 0;
+  SByteGenState sGen = bytegen_init(_frame(), FRAME_LEN);
+  for (uint32_t r = 0; r < u32Reps; ++r) {
+    bytegen_reset(&sGen);
+    while (!bytegen_end(&sGen)) {
+      u32Sum = CHECKSUM(u32Sum, bytegen_next(&sGen));
+      ++u32Out;
+    }
+  }
+  *pu32Sum = u32Sum;
+  return u32Out;
+}
+
+static uint32_t _bench_bitgen(uint32_t u32Reps, uint32_t *pu32Sum) {
+  uint32_t u32Out = 0;
+  uint32_t u32Sum = 0;
+  const uint8_t *pu8Frame = _frame();
+  SBitGenState sGen = bitgen_init(0, false, BIT_HI_LEN, BIT_LO_LEN);
+  for (uint32_t r = 0; r < u32Reps; ++r) {
+    for (int i = 0; i < FRAME_LEN; ++i) {
+      bitgen_resetv(&sGen, pu8Frame[i]);
+      while (!bitgen_end(&sGen)) {
+        u32Sum = CHECKSUM(u32Sum, bitgen_next(&sGen));
+        ++u32Out;
+      }
+    }
+  }
+  *pu32Sum = u32Sum;
+  return u32Out;
+}
+
+static uint32_t _bench_trbytegen(uint32_t u32Reps, uint32_t *pu32Sum) {
+  uint32_t u32Out = 0;
+  uint32_t u32Sum = 0;
+  SByteGenState sA = bytegen_init(_frame(), FRAME_LEN);
+  SBitGenState sB = bitgen_init(0, false, BIT_HI_LEN, BIT_LO_LEN);
+  STrByteGenState sGen = bitseqgen_init(&sA, &sB);
+  for (uint32_t r = 0; r < u32Reps; ++r) {
+    trbytegen_reset(&sGen);
+    while (!trbytegen_end(&sGen)) {
+      u32Sum = CHECKSUM(u32Sum, trbytegen_next(&sGen));
+      ++u32Out;
+    }
+  }
+  *pu32Sum = u32Sum;
+  return u32Out;
+}
+
+static uint32_t _bench_pwmgen(uint32_t u32Reps, uint32_t *pu32Sum) {
+  uint32_t u32Out = 0;
+  uint32_t u32Sum = 0;
+  SByteGenState sA = bytegen_init(_frame(), FRAME_LEN);
+  SBitGenState sB = bitgen_init(0, false, BIT_HI_LEN, BIT_LO_LEN);
+  STrByteGenState sBits = bitseqgen_init(&sA, &sB);
+  SPwmGenState sGen = pwmgen_init(&sBits, &gsBitSeqGenFunc, PWM_PERIOD, 0x80, 0x00);
+  for (uint32_t r = 0; r < u32Reps; ++r) {
+    pwmgen_reset(&sGen);
+    while (!pwmgen_end(&sGen)) {
+      u32Sum = CHECKSUM(u32Sum, pwmgen_next(&sGen));
+      ++u32Out;
+    }
+  }
+  *pu32Sum = u32Sum;
+  return u32Out;
+}
+
+static uint32_t _bench_pwmgen_fill(uint32_t u32Reps, uint32_t *pu32Sum) {
+  uint32_t u32Out = 0;
+  uint32_t u32Sum = 0;
+  uint32_t au32Buf[FILL_LEN];
+  SByteGenState sA = bytegen_init(_frame(), FRAME_LEN);
+  SBitGenState sB = bitgen_init(0, false, BIT_HI_LEN, BIT_LO_LEN);
+  STrByteGenState sBits = bitseqgen_init(&sA, &sB);
+  SPwmGenState sGen = pwmgen_init(&sBits, &gsBitSeqGenFunc, PWM_PERIOD, 0x80, 0x00);
+  for (uint32_t r = 0; r < u32Reps; ++r) {
+    pwmgen_reset(&sGen);
+    uint32_t u32Got;
+    while (0 < (u32Got = pwmgen_fill(&sGen, au32Buf, FILL_LEN))) {
+      u32Sum = _sum_pairs(u32Sum, au32Buf, u32Got, &u32Out);
+    }
+  }
+  *pu32Sum = u32Sum;
+  return u32Out;
+}
+
+static uint32_t _bench_bitpwmgen(uint32_t u32Reps, uint32_t *pu32Sum) {
+  uint32_t u32Out = 0;
+  uint32_t u32Sum = 0;
+  SBitPwmGenState sGen = _bitpwmgen_init();
+  for (uint32_t r = 0; r < u32Reps; ++r) {
+    bitpwmgen_reset(&sGen);
+    while (!bitpwmgen_end(&sGen)) {
+      u32Sum = CHECKSUM(u32Sum, bitpwmgen_next(&sGen));
+      ++u32Out;
+    }
+  }
+  *pu32Sum = u32Sum;
+  return u32Out;
+}
+
+static uint32_t _bench_bitpwmgen_fill(uint32_t u32Reps, uint32_t *pu32Sum) {
+  uint32_t u32Out = 0;
+  uint32_t u32Sum = 0;
+  uint32_t au32Buf[FILL_LEN];
+  SBitPwmGenState sGen = _bitpwmgen_init();
+  for (uint32_t r = 0; r < u32Reps; ++r) {
+    bitpwmgen_reset(&sGen);
+    uint32_t u32Got;
+    while (0 < (u32Got = bitpwmgen_fill(&sGen, au32Buf, FILL_LEN))) {
+      u32Sum = _sum_pairs(u32Sum, au32Buf, u32Got, &u32Out);
+    }
+  }
+  *pu32Sum = u32Sum;
+  return u32Out;
+}
+
+/**
+ * Bits of the frame through a fused byte pipeline (same checksum as trbytegen_next).
+ */
+static uint32_t _bench_genpipe_bit_fill(uint32_t u32Reps, uint32_t *pu32Sum) {
+  uint32_t u32Out = 0;
+  uint32_t u32Sum = 0;
+  uint8_t au8Buf[FILL_LEN];
+  GENPIPE_STATE(gbbit) sGen;
+  gbsrc_init(&sGen.sIn, _frame(), FRAME_LEN);
+  gbbit_init(&sGen, false, BIT_HI_LEN, BIT_LO_LEN);
+  for (uint32_t r = 0; r < u32Reps; ++r) {
+    gbbit_reset(&sGen);
+    uint32_t u32Got;
+    while (0 < (u32Got = gbbit_fill(&sGen, au8Buf, FILL_LEN))) {
+      for (uint32_t i = 0; i < u32Got; ++i) {
+        u32Sum = CHECKSUM(u32Sum, au8Buf[i]);
+      }
+      u32Out += u32Got;
+    }
+  }
+  *pu32Sum = u32Sum;
+  return u32Out;
+}
+
+static uint32_t _bench_genpipe_fill(uint32_t u32Reps, uint32_t *pu32Sum) {
+  uint32_t u32Out = 0;
+  uint32_t u32Sum = 0;
+  uint32_t au32Buf[FILL_LEN];
+  GENPIPE_STATE(gbpwm) sGen;
+  gbsrc_init(&sGen.sIn.sIn, _frame(), FRAME_LEN);
+  gbbit_init(&sGen.sIn, false, BIT_HI_LEN, BIT_LO_LEN);
+  gbpwm_init(&sGen, PWM_PERIOD, 0x80, 0x00);
+  for (uint32_t r = 0; r < u32Reps; ++r) {
+    gbpwm_reset(&sGen);
+    uint32_t u32Got;
+    while (0 < (u32Got = gbpwm_fill(&sGen, au32Buf, FILL_LEN))) {
+      u32Sum = _sum_pairs(u32Sum, au32Buf, u32Got, &u32Out);
+    }
+  }
+  *pu32Sum = u32Sum;
+  return u32Out;
+}
+
+static uint32_t _bench_stretchgen_fill(uint32_t u32Reps, uint32_t *pu32Sum) {
+  uint32_t u32Out = 0;
+  uint32_t u32Sum = 0;
+  uint32_t au32Buf[FILL_LEN];
+  SBitPwmGenState sGen = _bitpwmgen_init();
+  SStretchGenState sStretch = rmtutils_init_stretchgenstate(STRETCH_MUL, STRETCH_DIV,
+          (U16Generator) bitpwmgen_next, (UniRel) bitpwmgen_end, &sGen);
+  for (uint32_t r = 0; r < u32Reps; ++r) {
+    bitpwmgen_reset(&sGen);
+    uint32_t u32Got;
+    while (0 < (u32Got = rmtutils_stretchgen_fill(&sStretch, au32Buf, FILL_LEN))) {
+      u32Sum = _sum_pairs(u32Sum, au32Buf, u32Got, &u32Out);
+    }
+  }
+  *pu32Sum = u32Sum;
+  return u32Out;
+}
+
+static uint32_t _bench_rlstretchgen_fill(uint32_t u32Reps, uint32_t *pu32Sum) {
+  uint32_t u32Out = 0;
+  uint32_t u32Sum = 0;
+  uint32_t au32Buf[FILL_LEN];
+  SBitPwmGenState sGen = _bitpwmgen_init();
+  SRlStretchGenState sStretch = rmtutils_init_rlstretchgenstate(STRETCH_MUL, STRETCH_DIV,
+          (U16Generator) bitpwmgen_next, (UniRel) bitpwmgen_end, &sGen);
+  for (uint32_t r = 0; r < u32Reps; ++r) {
+    bitpwmgen_reset(&sGen);
+    uint32_t u32Got;
+    while (0 < (u32Got = rmtutils_rlstretchgen_fill(&sStretch, au32Buf, FILL_LEN))) {
+      u32Sum = _sum_pairs(u32Sum, au32Buf, u32Got, &u32Out);
+    }
+  }
+  *pu32Sum = u32Sum;
+  return u32Out;
+}
+
+/**
+ * Fused stretch pipeline, called through its function table (same checksum as stretchgen_fill).
+ */
+static uint32_t _bench_genpipe_stretch_fill(uint32_t u32Reps, uint32_t *pu32Sum) {
+  uint32_t u32Out = 0;
+  uint32_t u32Sum = 0;
+  uint32_t au32Buf[FILL_LEN];
+  GENPIPE_STATE(gbstretch) sGen;
+  gbsrc_init(&sGen.sIn.sIn.sIn, _frame(), FRAME_LEN);
+  gbbit_init(&sGen.sIn.sIn, false, BIT_HI_LEN, BIT_LO_LEN);
+  gbpwm_init(&sGen.sIn, PWM_PERIOD, 0x80, 0x00);
+  gbstretch_init(&sGen, STRETCH_MUL, STRETCH_DIV);
+  for (uint32_t r = 0; r < u32Reps; ++r) {
+    gsGbStretchFunc.fReset(&sGen);
+    uint32_t u32Got;
+    while (0 < (u32Got = gsGbStretchFunc.fFill(&sGen, au32Buf, FILL_LEN))) {
+      u32Sum = _sum_pairs(u32Sum, au32Buf, u32Got, &u32Out);
+    }
+  }
+  *pu32Sum = u32Sum;
+  return u32Out;
+}
+
+static uint32_t _bench_mphgen(uint32_t u32Reps, uint32_t *pu32Sum) {
+  uint32_t u32Out = 0;
+  uint32_t u32Sum = 0;
+  SByteGenState sText = bytegen_init((const uint8_t*) gacMessage, ARRAY_SIZE(gacMessage) - 1);
+  SMphGenState sGen = mphgen_init(&sText, true);
+  for (uint32_t r = 0; r < u32Reps; ++r) {
+    mphgen_reset(&sGen);
+    while (!mphgen_end(&sGen)) {
+      u32Sum = CHECKSUM(u32Sum, mphgen_next(&sGen));
+      ++u32Out;
+    }
+  }
+  *pu32Sum = u32Sum;
+  return u32Out;
+}
+
+static void _run(const void *pvCase, uint32_t u32Reps, SBenchResult *psRes) {
+  const SGenBenchCase *psCase = (const SGenBenchCase*) pvCase;
+  _frame();
+  uint32_t u32Start = bench_now();
+  psRes->u32Items = psCase->fCase(u32Reps, &psRes->u32Checksum);
+  psRes->u32Elapsed = bench_now() - u32Start;
+}
+
+// ====================== Interface functions =========================
+
+const SBenchSuite gsBenchSuite = {
+  BENCH_CASES(gasCases),
+  .fRun = _run,
+  .pcItem = "out",
+  .pcExtraUnit = NULL,
+  .bChecksum = true,
+  .u32HostReps = HOST_REPS,
+  .u32TargetReps = TARGET_REPS
+};
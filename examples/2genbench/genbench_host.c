@@ -0,0 +1,12 @@
+/*
+ * Copyright 2025 SZIGETI János
+ *
+ * This file is part of Bilis ESP32 Basic, which is released under GNU General Public License.version 3.
+ * See LICENSE or <https://www.gnu.org/licenses/> for full license details.
+ */
+#include "rmt.h"
+
+// ==================== Local Data ================
+// stand-ins for the linker-provided peripherals referenced by the RMT utilities (main() is in bench_host.c)
+RMT_Type gsRMT;
+Reg grRMTRAM[RMT_CHANNEL_NUM * RMT_RAM_BLOCK_SIZE];
@@ -0,0 +1,165 @@
+/*
+ * Copyright 2025 SZIGETI János
+ *
+ * This file is part of Bilis ESP32 Basic, which is released under GNU General Public License.version 3.
+ * See LICENSE or <https://www.gnu.org/licenses/> for full license details.
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "typeaux.h"
+#include "print.h"
+#include "bench.h"
+
+// =================== Hard constants =================
+#define VALUES 256U      ///< Size of the value set.
+#define PAD_WIDTH 10U    ///< Field width of the padded cases.
+#define OUT_LEN 24U      ///< Output buffer size (20 digits + terminating zero).
+#define HOST_REPS 2000U
+#define TARGET_REPS 10U
+
+// ============= Local types ===============
+
+/**
+ * Prints the value with the index into the buffer.
+ * @param pcDst Destination.
+ * @param szIdx Index of the value.
+ * @return End of the output.
+ */
+typedef char *(*FPrintBenchCase)(char *pcDst, size_t szIdx);
+
+typedef struct {
+  const char *pcName;
+  FPrintBenchCase fCase;
+  FPrintBenchCase fRef; ///< Reference of the output.
+} SPrintBenchCase;
+
+// ================ Local function declarations =================
+static void _init_values();
+static char *_ref_dec64(char *pcDst, uint64_t u64Value);
+static char *_case_dec(char *pcDst, size_t szIdx);
+static char *_case_dec32(char *pcDst, size_t szIdx);
+static char *_case_padded(char *pcDst, size_t szIdx);
+static char *_case_padded32(char *pcDst, size_t szIdx);
+static char *_case_ref64(char *pcDst, size_t szIdx);
+static char *_case_dec64(char *pcDst, size_t szIdx);
+static void _run(const void *pvCase, uint32_t u32Reps, SBenchResult *psRes);
+
+// =================== Global constants ================
+
+static const SPrintBenchCase gasCases[] = {
+  {"dec_ref", _case_dec, _case_dec},
+  {"dec32", _case_dec32, _case_dec},
+  {"padded_ref", _case_padded, _case_padded},
+  {"padded32", _case_padded32, _case_padded},
+  {"dec64_ref", _case_ref64, _case_ref64},
+  {"dec64", _case_dec64, _case_ref64},
+};
+
+// ==================== Local Data ================
+static uint32_t gau32Values[VALUES];
+static uint64_t gau64Values[VALUES];
+static bool gbValuesReady = false;
+
+// ==================== Implementation ================
+
+/**
+ * Pseudo-random values with uniformly distributed number of digits (LCG).
+ */
+static void _init_values() {
+  uint32_t u32Seed = 12345U;
+  for (size_t i = 0; i < VALUES; ++i) {
+    u32Seed = u32Seed * 1664525U + 1013904223U;
+    uint32_t u32Hi = u32Seed;
+    u32Seed = u32Seed * 1664525U + 1013904223U;
+    gau32Values[i] = u32Seed >> (i % 32);
+    if (!gau32Values[i]) {
+      gau32Values[i] = 1; // print_dec() prints 0 as an empty string
+    }
+    gau64Values[i] = (((uint64_t) u32Hi << 32) | u32Seed) >> (i % 64);
+  }
+  gbValuesReady = true;
+}
+
+/**
+ * Reference: one 64 bit division per digit, then reversal.
+ */
+static char *_ref_dec64(char *pcDst, uint64_t u64Value) {
+  char *pcEnd = pcDst;
+  do {
+    *(pcEnd++) = '0' + u64Value % 10U;
+    u64Value /= 10U;
+  } while (u64Value);
+  for (char *pcL = pcDst, *pcR = pcEnd - 1; pcL < pcR; ++pcL, --pcR) {
+    char c = *pcL;
+    *pcL = *pcR;
+    *pcR = c;
+  }
+  *pcEnd = 0;
+  return pcEnd;
+}
+
+static char *_case_dec(char *pcDst, size_t szIdx) {
+  return print_dec(pcDst, gau32Values[szIdx]);
+}
+
+static char *_case_dec32(char *pcDst, size_t szIdx) {
+  return print_dec32(pcDst, gau32Values[szIdx]);
+}
+
+static char *_case_padded(char *pcDst, size_t szIdx) {
+  return print_dec_padded(pcDst, gau32Values[szIdx], PAD_WIDTH, '0');
+}
+
+static char *_case_padded32(char *pcDst, size_t szIdx) {
+  return print_dec32_padded(pcDst, gau32Values[szIdx], PAD_WIDTH, '0');
+}
+
+static char *_case_ref64(char *pcDst, size_t szIdx) {
+  return _ref_dec64(pcDst, gau64Values[szIdx]);
+}
+
+static char *_case_dec64(char *pcDst, size_t szIdx) {
+  return print_dec64(pcDst, gau64Values[szIdx]);
+}
+
+static void _run(const void *pvCase, uint32_t u32Reps, SBenchResult *psRes) {
+  const SPrintBenchCase *psCase = (const SPrintBenchCase*) pvCase;
+  char acOut[OUT_LEN];
+  char acRef[OUT_LEN];
+  volatile char cSink = 0;
+
+  if (!gbValuesReady) {
+    _init_values();
+  }
+  uint32_t u32Start = bench_now();
+  for (uint32_t r = 0; r < u32Reps; ++r) {
+    for (size_t i = 0; i < VALUES; ++i) {
+      cSink += *(psCase->fCase(acOut, i) - 1);
+    }
+  }
+  psRes->u32Elapsed = bench_now() - u32Start;
+  psRes->u32Items = u32Reps * VALUES;
+
+  for (size_t i = 0; i < VALUES; ++i) {
+    size_t szLen = psCase->fCase(acOut, i) - acOut;
+    size_t szRefLen = psCase->fRef(acRef, i) - acRef;
+    if (szLen != szRefLen || 0 != memcmp(acOut, acRef, szLen)) {
+      ++psRes->u32Mismatches;
+    }
+  }
+}
+
+// ====================== Interface functions =========================
+
+const SBenchSuite gsBenchSuite = {
+  BENCH_CASES(gasCases),
+  .fRun = _run,
+  .pcItem = "num",
+  .pcExtraUnit = NULL,
+  .bChecksum = false,
+  .u32HostReps = HOST_REPS,
+  .u32TargetReps = TARGET_REPS
+};
@@ -28,7 +28,12 @@
 #include "typeaux.h"
 #include "bme280.h"
 #include "bh1750.h"
+#include "ssd1306.h"
 #include "utils/i2cutils.h"
+#include "utils/timeseries.h"
+#include "utils/shell.h"
+#include "utils/trace.h"
+#include "utils/uartutils.h"
 
 // =================== Hard constants =================
 // #1: Timings
@@ -36,13 +41,12 @@
 #define LED_BLINK_HPERIOD1_MS 250U
 #define OLED_PERIOD_MS 100U
 #define BH1750_PERIOD_MS 1333U
-#define BME280_PERIOD_MS 5200U
+#define BME280_START_MS 5200U
 #define LOG_PERIOD_MS 4000U
 #define INC_PERIOD_MS 1900U
 #define I2CSCAN_PERIOD_MS 8600U
 #define ALARM_PERIOD_MS 4500U
-
-#define BH1750_RETRY_WAIT_HMS 10U
+#define MAX_PERIOD_MS 60000U ///< Upper limit of the periods set from the shell.
 
 // #2: Channels / wires / addresses
 #define I2C0_SCL_GPIO 22U
@@ -59,12 +63,18 @@
 #define BME280_I2C_CH I2C1
 #define BME280_I2C_SLAVEADDR 0x76
 
+#define UARTINT_CH 23U
+
 // #3: Sizes
 #define LOG_BUFLEN 120
+#define UART_TXBUF_LEN 2048U
+#define UART_RXBUF_LEN 256U
+#define TRACE_BUFLEN 512U
 #define I2CSCAN_PRINT_PER_ROW 8
 
 // #4: Others
-#define BH1750_READ_RETRIES 5U
+#define BME280_STANDBY BME280_TSB_1000MS
+#define BME280_FILTER BME280_IIR_4
 
 // ============= Local types ===============
 
@@ -79,19 +89,6 @@ typedef struct {
   uint8_t prio;
 } InterruptDesc;
 
-typedef enum {
-  DISPLAY_INIT,
-  DISPLAY_CLRSCR,
-  DISPLAY_NORMAL
-} EDisplayState;
-
-typedef enum {
-  BH1750_PH_INIT,
-  BH1750_PH_RESET,
-  BH1750_PH_MEASURE,
-  BH1750_PH_READ
-} EBh1750Phase;
-
 typedef struct {
   InterruptEntry sRoutine;
   uint64_t u64tckAlarmCur;
@@ -101,6 +98,11 @@ typedef struct {
   ECpu eCpu;
 } PeriodicCallbackDesc;
 
+typedef struct {
+  const char *pcName;
+  volatile uint32_t *pu32ms;
+} SPeriodEntry;
+
 // ================ Local function declarations =================
 static void _uart_println(const char *pcPrefix, const char *pcLine, uint8_t u8Len);
 static void _flush_message(uint64_t u64tckTimestamp);
@@ -114,14 +116,21 @@ static void _i2c_release_cycle(uint64_t u64Ticks);
 static void _switch_leds_init(TimerId sTimer);
 static void _switch_leds_cycle(uint64_t u64Ticks);
 static void _oled_cycle(uint64_t u64Ticks);
-static void _bh1750_init(SBh1750StateDesc *psState, SI2cIfaceCfg *psIface);
-static void _bh1750_print_result(const SBh1750StateDesc *psState);
+static void _bh1750_init(SBh1750Auto *psAuto, uint64_t *pu64Ticks);
+static void _bh1750_print_result(const SBh1750Auto *psAuto);
+static void _bh1750_sample(void *pvParam, uint32_t u32mLx);
 static void _bh1750_cycle(uint64_t u64Ticks);
-static void _bme280_init(SBme280StateDesc *psState, SI2cIfaceCfg *psIface);
+static void _bme280_init(SBme280Stream *psStream, uint64_t *pu64Ticks);
 static void _bme280_print_result(const SBme280TPH *psRes, uint32_t u32TFine);
+static void _bme280_sample(void *pvParam, const SBme280TPH *psRes, uint32_t u32TFine);
 static void _bme280_cycle(uint64_t u64Ticks);
+static void _log_series(const char *pcPrefix, const STimeSeries *psSeries, uint32_t u32msNow, bool bMilli);
 static void _log_cycle(uint64_t u64Ticks);
 static void _inc_cycle(uint64_t u64Ticks);
+static void _cmd_period(void *pvArg, uint8_t u8Argc, char *const *ppcArgv);
+static void _cmd_stats(void *pvArg, uint8_t u8Argc, char *const *ppcArgv);
+static void _cmd_scan(void *pvArg, uint8_t u8Argc, char *const *ppcArgv);
+static void _shell_cycle(uint64_t u64Ticks);
 
 // =================== Global constants ================
 const bool gbStartAppCpu = START_APP_CPU;
@@ -134,28 +143,37 @@ static const char message_sfx[] = " ms\r\n";
 static const char acLedPhase[] = "*O";
 
 static UART_Type *gpsUART0 = &gsUART0;
+static char gacUartTxBuf[UART_TXBUF_LEN];
+static SUartTxRing gsUartTx;
+static uint8_t gau8TraceBuf[TRACE_BUFLEN];
+static STraceLog gsTrace; ///< Binary trace of the PRO CPU cycle (decode it with scripts/tracedecode.py).
+static char gacUartRxBuf[UART_RXBUF_LEN];
+static SUartRxRing gsUartRx;
+static SShell gsShell;
+static volatile bool gbScanRequest = false;
+// periods that can be changed from the shell
+static volatile uint32_t gu32msOledPeriod = OLED_PERIOD_MS;
+static volatile uint32_t gu32msBh1750Period = BH1750_PERIOD_MS;
+static volatile uint32_t gu32msLogPeriod = LOG_PERIOD_MS;
+static volatile uint32_t gu32msI2cScanPeriod = I2CSCAN_PERIOD_MS;
+static SPeriodEntry gasPeriods[] = {
+  {"oled", &gu32msOledPeriod},
+  {"bh1750", &gu32msBh1750Period},
+  {"log", &gu32msLogPeriod},
+  {"scan", &gu32msI2cScanPeriod}
+};
+static const SShellCmd gasShellCmds[] = {
+  {"period", "<oled|bh1750|log|scan> [ms]", _cmd_period, NULL},
+  {"stats", "", _cmd_stats, NULL},
+  {"scan", "", _cmd_scan, NULL}
+};
 static volatile bool gbLedState = false;
-static volatile EDisplayState geOledState = DISPLAY_INIT;
 static volatile uint64_t gu64tckAlarmCur = 0;
 static volatile uint32_t gau32IncVal[] = {0, 0, 0, 0};
 static volatile uint32_t gu32MutexIncProc = 0;
 static const uint8_t gau8LedGpio [] = {2, 4};
-const char gacOledStartSeq[] = {
-  0x00, // command sequence begins
-  0xA8, 0x3F, 0xD3, 0x00, // Set MUX ratio, Set display offset
-  0x40, 0x20, 0x01, 0xA0, // Set display start line, Set segment re-map
-  0xC0, 0xDA, 0x02, // Set COM Output scan direction, Set COM pins hw config
-  0x81, 0x0F, // Set contrast ctrl
-  0xA4, 0xA6, // Disable entire display ON, Set normal display,
-  0xD5, 0x80, 0x8D, 0x14, // Set OSC frequency, Enable charge pump regulator
-  0xAF, // Display on
-  0x00, 0x10, // Reset Column
-  0x22, 0x00, 0x03 // Addressing page range [0,3]
-};
-char gacOledDataSeq[] = {// shift = 3
-  0x00, 0x00, 0x00, 0x40, // data sequence begins
-  0xAA, 0xAA, 0xAA, 0xAA
-};
+static STimeSeries gsTempSeries; ///< BME280 temperature (0.01 °C).
+static STimeSeries gsLightSeries; ///< BH1750 illuminance (mLx).
 
 static PeriodicCallbackDesc gsPCbDesc = {
   //  .eCpu = CPU_PRO,
@@ -175,14 +193,14 @@ static PeriodicCallbackDesc gsPCbDesc = {
 
 static void _uart_println(const char *pcPrefix, const char *pcLine, uint8_t u8Len) {
   uint32_t u32PfxLen = strlen(pcPrefix);
-  for (int i = 0; i < u32PfxLen; ++i) {
-    gpsUART0->FIFO = pcPrefix[i];
-  }
-  for (int i = 0; i < u8Len; ++i) {
-    gpsUART0->FIFO = pcLine[i];
+  // the line is either enqueued as a whole or dropped
+  if (uart_tx_free(&gsUartTx) < u32PfxLen + u8Len + 2) {
+    ++gsUartTx.u32Dropped;
+    return;
   }
-  gpsUART0->FIFO = '\r';
-  gpsUART0->FIFO = '\n';
+  uart_tx_enqueue(&gsUartTx, pcPrefix, u32PfxLen);
+  uart_tx_enqueue(&gsUartTx, pcLine, u8Len);
+  uart_tx_enqueue(&gsUartTx, "\r\n", 2);
 }
 
 static void _flush_message(uint64_t u64tckTimestamp) {
@@ -191,16 +209,16 @@ static void _flush_message(uint64_t u64tckTimestamp) {
   char *buf_e = buf;
 
   uint64_t u64TsDecimal = u64tckTimestamp / TICKS_PER_MS; // milliseconds, max. ~ 48 bits.
-  uint32_t u32TsDecimalHi = u64TsDecimal / 1000; // seconds, FIXME: max. ~ 38 bits, does not fit into uint32_t
+  uint64_t u64TsDecimalHi = u64TsDecimal / 1000; // seconds, max. ~ 38 bits
   uint32_t u32TsDecimalLo = u64TsDecimal % 1000; // ms part of the timestamp
   uint32_t u32TsFractional = (u64tckTimestamp % TICKS_PER_MS) * (1000000 / TICKS_PER_MS); // µs and ns, 6 digits
 
   if (true) {
-    buf_e = print_dec(buf_e, u32TsDecimalHi);
+    buf_e = print_dec64(buf_e, u64TsDecimalHi);
     *(buf_e++) = ' ';
-    buf_e = print_dec_padded(buf_e, u32TsDecimalLo, 3, '0');
+    buf_e = print_dec32_padded(buf_e, u32TsDecimalLo, 3, '0');
     *(buf_e++) = '.';
-    buf_e = print_dec_padded(buf_e, u32TsFractional, 6, '0');
+    buf_e = print_dec32_padded(buf_e, u32TsFractional, 6, '0');
     buf_e = str_append(buf_e, " ms");
     for (int i = 0; i < 0; ++i) {
       *(buf_e++) = ' ';
@@ -264,7 +282,14 @@ static void _init_drivers() {
 }
 
 static void _init_uart() {
-  gpsUART0->CLKDIV.u20ClkDiv = APB_FREQ_HZ / UART_FREQ_HZ;
+  uart_set_baudrate(gpsUART0, APB_FREQ_HZ, UART_FREQ_HZ);
+  uart_set_format(gpsUART0, UART_DATA_8BITS, UART_PARITY_NONE, UART_STOP_1);
+  gsUartTx = uart_tx_init(gpsUART0, gacUartTxBuf, UART_TXBUF_LEN);
+  uart_tx_isr_start(&gsUartTx, CPU_PRO, UARTINT_CH);
+  gsTrace = trace_init(gau8TraceBuf, TRACE_BUFLEN);
+  gsUartRx = uart_rx_init(gpsUART0, gacUartRxBuf, UART_RXBUF_LEN);
+  uart_rx_isr_start(&gsUartRx, CPU_PRO, UARTINT_CH);
+  gsShell = shell_init(&gsUartRx, gpsUART0, gasShellCmds, ARRAY_SIZE(gasShellCmds));
 }
 
 // TODO: make it an ISR and attach to I2C INT
@@ -309,7 +334,7 @@ static void _switch_leds_cycle(uint64_t u64Ticks) {
     gpio_reg_setbit(aprGpioOut[bPhase], gau8LedGpio[0]);
     gpio_reg_setbit(aprGpioOut[!bPhase], gau8LedGpio[1]);
     if (false) {
-      gpsUART0->FIFO = acLedPhase[bPhase];
+      uart_tx_enqueue(&gsUartTx, &acLedPhase[bPhase], 1);
     }
     bPhase = !bPhase;
     u64NextTick += MS2TICKS(gbLedState ? LED_BLINK_HPERIOD1_MS : LED_BLINK_HPERIOD0_MS);
@@ -326,75 +351,55 @@ static void _oled_cycle(uint64_t u64Ticks) {
   static uint32_t u32Div0 = 6;
   static uint32_t u32Mul1 = 3;
   static uint32_t u32Div1 = 7;
-  static uint32_t u32ClrSrcPtr = 0;
-  static uint32_t u32LastLabel;
+  static uint8_t u8Col = 0;
+  static SSsd1306StateDesc sOled;
+  static SI2cIfaceCfg sIface;
   static bool bFirstRun = true;
 
-  if (u64NextTick <= u64Ticks) {
-    uint32_t u32NextLabel;
-    if (lockmgr_acquire_lock(_i2c_to_lock(OLED_I2C_CH), &u32NextLabel)) {
-      if (!bFirstRun) {
-        AsyncResultEntry *psEntry = lockmgr_get_entry(u32LastLabel);
-        bool bErr = (0 < (psEntry->u32IntSt & I2C_INT_MASK_ERR));
-        if (!bErr) {
-          if (geOledState == DISPLAY_INIT) {
-            geOledState = DISPLAY_CLRSCR;
-          } else if (geOledState == DISPLAY_CLRSCR) {
-            ++u32ClrSrcPtr;
-            if (u32ClrSrcPtr == 256) {
-              geOledState = DISPLAY_NORMAL;
-            }
-          }
-        }
-        lockmgr_release_entry(u32LastLabel);
-      }
-      bFirstRun = false;
-      u32LastLabel = u32NextLabel;
-
-      switch (geOledState) {
-        case DISPLAY_INIT:
-          i2c_write(OLED_I2C_CH, OLED_I2C_SLAVEADDR, ARRAY_SIZE(gacOledStartSeq), (const uint8_t*) gacOledStartSeq);
-          break;
-        case DISPLAY_CLRSCR:
-          i2c_write(OLED_I2C_CH, OLED_I2C_SLAVEADDR, ARRAY_SIZE(gacOledDataSeq) - 3, (const uint8_t*) gacOledDataSeq + 3);
-          break;
-        default:
-        {
-          uint8_t u8X0 = (u32Value0 * u32Mul0 / u32Div0) & 0x1F;
-          uint8_t u8X1 = 31 - ((u32Value1 * u32Mul1 / u32Div1) & 0x1F);
-          uint32_t u32Pattern = u8X1 < u8X0 ? ((1 << u8X0) - (1 << u8X1)) : ~((1 << u8X1) - (1 << u8X0));
-          *((uint32_t*) (&gacOledDataSeq[4])) = u32Pattern;
-
-          i2c_write(OLED_I2C_CH, OLED_I2C_SLAVEADDR, ARRAY_SIZE(gacOledDataSeq) - 3, (const uint8_t*) gacOledDataSeq + 3);
-
-          u64NextTick += MS2TICKS(OLED_PERIOD_MS);
-          ++u32Value0;
-          if (32U * u32Div0 <= u32Value0) {
-            u32Value0 = 0;
-          }
-          ++u32Value1;
-          if (32U * u32Div1 <= u32Value1) {
-            u32Value1 = 0;
-          }
-        }
-      }
+  if (bFirstRun) {
+    sOled = ssd1306_init_state(); // the first flush clears the display
+    sIface.eBus = OLED_I2C_CH;
+    sIface.eLck = _i2c_to_lock(OLED_I2C_CH);
+    sIface.u8SlaveAddr = OLED_I2C_SLAVEADDR;
+    bFirstRun = false;
+  }
+
+  // the next column is drawn only when the previous one is on the display
+  if (ssd1306_async_rx_cycle(&sOled) && u64NextTick <= u64Ticks) {
+    uint8_t u8X0 = (u32Value0 * u32Mul0 / u32Div0) & 0x1F;
+    uint8_t u8X1 = 31 - ((u32Value1 * u32Mul1 / u32Div1) & 0x1F);
+    uint32_t u32Pattern = u8X1 < u8X0 ? ((1 << u8X0) - (1 << u8X1)) : ~((1 << u8X1) - (1 << u8X0));
+    ssd1306_set_column(&sOled, u8Col, u32Pattern);
+    u8Col = (u8Col + 1) % SSD1306_WIDTH;
+
+    u64NextTick += MS2TICKS(gu32msOledPeriod);
+    ++u32Value0;
+    if (32U * u32Div0 <= u32Value0) {
+      u32Value0 = 0;
+    }
+    ++u32Value1;
+    if (32U * u32Div1 <= u32Value1) {
+      u32Value1 = 0;
     }
   }
+  ssd1306_async_tx_cycle(&sIface, &sOled);
 }
 
 // Section BME280
 
-static void _bme280_init(SBme280StateDesc *psState, SI2cIfaceCfg *psIface) {
-  *psState = bme280_init_state();
-  bme280_set_osrs_h(psState, BME280_OSRS_8);
-  bme280_set_osrs_t(psState, BME280_OSRS_8);
-  bme280_set_osrs_p(psState, BME280_OSRS_8);
-  bme280_set_mode_forced(psState);
-  *psIface = (SI2cIfaceCfg){
+/**
+ * Initializes the BME280 stream: normal mode, the device converts in every ~1 s.
+ * @param psStream Stream descriptor.
+ * @param pu64Ticks Time of the current stream cycle (passed to the sample callback).
+ */
+static void _bme280_init(SBme280Stream *psStream, uint64_t *pu64Ticks) {
+  SI2cIfaceCfg sIface = {
     .eBus = BME280_I2C_CH,
     .eLck = _i2c_to_lock(BME280_I2C_CH),
     .u8SlaveAddr = BME280_I2C_SLAVEADDR
   };
+  *psStream = bme280_stream_init(&sIface, BME280_OSRS_8, BME280_OSRS_8, BME280_OSRS_8,
+          BME280_STANDBY, BME280_FILTER, _bme280_sample, pu64Ticks);
 }
 
 static void _bme280_print_result(const SBme280TPH *psRes, uint32_t u32TFine) {
@@ -414,141 +419,156 @@ static void _bme280_print_result(const SBme280TPH *psRes, uint32_t u32TFine) {
   _uart_println("Hum: ", acBuf, bufE - acBuf);
 }
 
+/**
+ * Sample callback of the BME280 stream.
+ * @param pvParam Time of the current stream cycle.
+ * @param psRes Compensated sample.
+ * @param u32TFine t_fine value.
+ */
+static void _bme280_sample(void *pvParam, const SBme280TPH *psRes, uint32_t u32TFine) {
+  uint64_t u64Ticks = *(const uint64_t*) pvParam;
+  _bme280_print_result(psRes, u32TFine);
+  timeseries_add(&gsTempSeries, u64Ticks / TICKS_PER_MS, psRes->i32Temp);
+}
+
 static void _bme280_cycle(uint64_t u64Ticks) {
-  static uint64_t u64NextTick = MS2TICKS(BME280_PERIOD_MS);
+  static uint64_t u64NextTick = MS2TICKS(BME280_START_MS);
   static bool bFirstRun = true;
-  static SBme280StateDesc sState;
-  static SI2cIfaceCfg sIface;
+  static SBme280Stream sStream;
+  static uint64_t u64CycleTicks;
 
   if (bFirstRun) {
-    _bme280_init(&sState, &sIface);
+    _bme280_init(&sStream, &u64CycleTicks);
+    timeseries_init(&gsTempSeries);
     bFirstRun = false;
   }
 
   if (u64NextTick <= u64Ticks) {
-    uint32_t u32hmsWaitHint = 0;
-    bme280_async_rx_cycle(&sState, &u32hmsWaitHint);
-    if (bme280_is_data_updated(&sState)) {
-      uint32_t u32TFine;
-      SBme280TPH sResult = bme280_get_measurement(&sState, &u32TFine);
-      _bme280_print_result(&sResult, u32TFine);
-      bme280_ack_data_updated(&sState);
-      bme280_set_mode_forced(&sState);
-      u64NextTick += MS2TICKS(BME280_PERIOD_MS);
-    } else {
-      if (u32hmsWaitHint == 0) {
-        bme280_async_tx_cycle(&sIface, &sState);
-      } else {
-        u64NextTick += MS2TICKS(u32hmsWaitHint) / 2;
-      }
-    }
+    u64CycleTicks = u64Ticks;
+    uint32_t u32hmsWaitHint = bme280_stream_cycle(&sStream);
+    // scheduled from the previous deadline, so the reads keep the cadence of the device
+    u64NextTick += MS2TICKS(u32hmsWaitHint) / 2;
   }
 }
 
 // Section BH1750FVI
 
-static void _bh1750_init(SBh1750StateDesc *psState, SI2cIfaceCfg *psIface) {
-  *psState = bh1750_init_state();
-  *psIface = (SI2cIfaceCfg){
-    .eBus = BME280_I2C_CH,
+/**
+ * Initializes the BH1750 auto-ranging driver.
+ * @param psAuto Driver descriptor.
+ * @param pu64Ticks Time of the current driver cycle (passed to the sample callback).
+ */
+static void _bh1750_init(SBh1750Auto *psAuto, uint64_t *pu64Ticks) {
+  SI2cIfaceCfg sIface = {
+    .eBus = BH1750_I2C_CH,
     .eLck = _i2c_to_lock(BH1750_I2C_CH),
     .u8SlaveAddr = BH1750_I2C_SLAVEADDR
   };
+  *psAuto = bh1750_auto_init(&sIface, _bh1750_sample, pu64Ticks);
 }
 
-static void _bh1750_print_result(const SBh1750StateDesc *psState) {
+static void _bh1750_print_result(const SBh1750Auto *psAuto) {
   static const char *acBh1750MResName[] = {
     "H", "H2", "XX", "L"
   };
-  EBh1750MeasRes eMRes = bh1750_get_mres(psState);
-  uint8_t u8MTime = bh1750_get_mtime(psState);
-  uint8_t u16Result = conv16be(psState->u16beResult);
-  uint32_t u32mLx = bh1750_result_to_mlx(u16Result, u8MTime, eMRes);
   char acBuf[40];
   char *pcBufE = acBuf;
-  pcBufE = str_append(pcBufE, acBh1750MResName[eMRes]);
+  pcBufE = str_append(pcBufE, acBh1750MResName[psAuto->eMRes]);
+  *(pcBufE++) = '/';
+  pcBufE = print_dec(pcBufE, psAuto->u8MTime);
   pcBufE = str_append(pcBufE, ": ");
-  pcBufE = print_decmilli(pcBufE, u32mLx, '.');
+  pcBufE = print_decmilli(pcBufE, psAuto->u32mLx, '.');
 
   _uart_println("BH1750 ", acBuf, pcBufE - acBuf);
 }
 
+/**
+ * Sample callback of the BH1750 driver.
+ * @param pvParam Time of the current driver cycle.
+ * @param u32mLx Illuminance.
+ */
+static void _bh1750_sample(void *pvParam, uint32_t u32mLx) {
+  uint64_t u64Ticks = *(const uint64_t*) pvParam;
+  timeseries_add(&gsLightSeries, u64Ticks / TICKS_PER_MS, u32mLx);
+  TRACE2(&gsTrace, "BH1750 sample: %u mLx @ %u ms\r\n", u32mLx, u64Ticks / TICKS_PER_MS);
+}
+
+/**
+ * The samples are taken back-to-back (at the measurement time cadence), and all of them are stored;
+ * the latest one is printed in every gu32msBh1750Period.
+ * @param u64Ticks Current time in ticks.
+ */
 static void _bh1750_cycle(uint64_t u64Ticks) {
-  const uint8_t u8MTimeMin = 31;
-  const uint8_t u8MTimeMax = 254;
+  static uint64_t u64NextTick = 0;
+  static uint64_t u64NextPrintTick = MS2TICKS(BH1750_PERIOD_MS);
+  static bool bFirstRun = true;
+  static SBh1750Auto sAuto;
+  static uint64_t u64CycleTicks;
+  static uint32_t u32PrintedSamples = 0;
 
-  static uint64_t u64NextTick = MS2TICKS(BH1750_PERIOD_MS);
-  static SBh1750StateDesc sState;
-  static SI2cIfaceCfg sIface;
-  static EBh1750Phase ePhase = BH1750_PH_INIT;
-  static uint8_t u8Retries = BH1750_READ_RETRIES;
-  static uint8_t u8MTime = 69;
+  if (bFirstRun) {
+    _bh1750_init(&sAuto, &u64CycleTicks);
+    timeseries_init(&gsLightSeries);
+    bFirstRun = false;
+  }
 
   if (u64NextTick <= u64Ticks) {
-    if (ePhase == BH1750_PH_INIT) {
-      _bh1750_init(&sState, &sIface);
-    }
-    uint32_t u32hmsWaitHint = 0;
-    bool bResultReady = false;
-    bool bSeqReady = bh1750_async_rx_cycle(&sState, &u32hmsWaitHint);
-    if (bSeqReady) {
-      switch (ePhase) {
-        case BH1750_PH_MEASURE:
-          // switch to read
-          ePhase = BH1750_PH_READ;
-          bh1750_read(&sState);
-          break;
-        case BH1750_PH_READ:
-          // check result and conditionally switch to reset
-          if (0 != sState.u16beResult || 0 == u8Retries--) {
-            ePhase = BH1750_PH_RESET;
-            bh1750_reset(&sState); // in case of one-time measurement this command implies POWER_ON
-            bResultReady = true;
-            u8Retries = BH1750_READ_RETRIES;
-          } else {
-            // EITHER 0 was measured OR result still not ready
-            _uart_println("BH1750 retry", NULL, 0);
-            u32hmsWaitHint += BH1750_RETRY_WAIT_HMS; // so let's wait some dt
-          }
-          break;
-        case BH1750_PH_RESET: // result register is reset
-        case BH1750_PH_INIT: // there was no action before
-          // switch to measure
-          ePhase = BH1750_PH_MEASURE;
-          bh1750_measure(&sState, false, bh1750_measres_next(bh1750_get_mres(&sState)));
-          if (bh1750_get_mres(&sState) == BH1750_RES_H) {
-            do {
-              u8MTime += 5;
-            } while (u8MTime < u8MTimeMin || u8MTimeMax < u8MTime);
-            bh1750_set_mtime(&sState, u8MTime);
-          }
-          break;
-        default:
-          ;
-      }
-    }
-    if (bResultReady) {
-      _bh1750_print_result(&sState);
-      u64NextTick += MS2TICKS(BH1750_PERIOD_MS);
-    } else { // TX side
-      if (u32hmsWaitHint == 0) {
-        bh1750_async_tx_cycle(&sIface, &sState);
-      } else {
-        u64NextTick += MS2TICKS(u32hmsWaitHint) / 2;
-      }
-    }
+    u64CycleTicks = u64Ticks;
+    u64NextTick = u64Ticks + MS2TICKS(bh1750_auto_cycle(&sAuto)) / 2;
+  }
+  if (u64NextPrintTick <= u64Ticks && u32PrintedSamples != sAuto.u32Samples) {
+    _bh1750_print_result(&sAuto);
+    u32PrintedSamples = sAuto.u32Samples;
+    u64NextPrintTick = u64Ticks + MS2TICKS(gu32msBh1750Period);
   }
 }
 
 
 // Logger
 
+/**
+ * Prints the min / mean / max of the last minute of a time-series.
+ * @param pcPrefix Line prefix.
+ * @param psSeries Time-series.
+ * @param u32msNow Current time.
+ * @param bMilli Values are in 0.001 units (otherwise 0.01).
+ */
+static void _log_series(const char *pcPrefix, const STimeSeries *psSeries, uint32_t u32msNow, bool bMilli) {
+  STsAggregate sAggr;
+  if (!timeseries_window(psSeries, TS_TIER_SEC, u32msNow - TIMESERIES_MIN_MS, u32msNow + 1, &sAggr)) {
+    return;
+  }
+  int32_t ai32Values[] = {sAggr.i32Min, timeseries_mean(&sAggr), sAggr.i32Max};
+  char acBuf[48];
+  char *pcBufE = acBuf;
+  for (int i = 0; i < ARRAY_SIZE(ai32Values); ++i) {
+    if (0 != i)
+      *(pcBufE++) = '/';
+    pcBufE = bMilli ?
+            print_decmilli(pcBufE, ai32Values[i], '.') :
+            print_deccent(pcBufE, ai32Values[i], '.');
+  }
+  _uart_println(pcPrefix, acBuf, pcBufE - acBuf);
+}
+
 static void _log_cycle(uint64_t u64Ticks) {
   static uint64_t u64NextTick = 0;
+  static uint8_t u8Phase = 0;
 
+  trace_flush(&gsTrace, &gsUartTx);
   if (u64NextTick <= u64Ticks) {
-    _flush_message(u64Ticks);
-    u64NextTick += MS2TICKS(LOG_PERIOD_MS);
+    uint32_t u32msNow = u64Ticks / TICKS_PER_MS;
+    switch (u8Phase++ % 3) {
+      case 0:
+        _flush_message(u64Ticks);
+        break;
+      case 1:
+        _log_series("Temp 1m min/avg/max: ", &gsTempSeries, u32msNow, false);
+        break;
+      default:
+        _log_series("Light 1m min/avg/max: ", &gsLightSeries, u32msNow, true);
+    }
+    u64NextTick += MS2TICKS(gu32msLogPeriod) / 3;
   }
 }
 
@@ -592,6 +612,10 @@ static void _i2cscan_cycle(uint64_t u64Ticks) {
     sIface.eLck = _i2c_to_lock(OLED_I2C_CH);
     bFirstRun = false;
   }
+  if (gbScanRequest) {
+    u64NextTick = u64Ticks;
+    gbScanRequest = false;
+  }
 
   if (u64NextTick <= u64Ticks) {
     if (i2cutils_scan_cycle(&sIface, &sState)) {
@@ -611,12 +635,49 @@ static void _i2cscan_cycle(uint64_t u64Ticks) {
         _uart_println(acPfx, acBuf, pcBufE - acBuf);
       }
 
-      u64NextTick += MS2TICKS(I2CSCAN_PERIOD_MS);
+      u64NextTick += MS2TICKS(gu32msI2cScanPeriod);
       sState = i2cutil_scan_init();
     }
   }
 }
 
+// Shell
+
+/**
+ * period <name> [ms]: prints / sets the period of a task.
+ */
+static void _cmd_period(void *pvArg, uint8_t u8Argc, char *const *ppcArgv) {
+  for (uint8_t i = 0; 1 < u8Argc && i < ARRAY_SIZE(gasPeriods); ++i) {
+    if (0 == strcmp(ppcArgv[1], gasPeriods[i].pcName)) {
+      uint32_t u32ms;
+      if (2 < u8Argc) {
+        if (!shell_parse_u32(ppcArgv[2], &u32ms) || 0 == u32ms || MAX_PERIOD_MS < u32ms) {
+          uart_printf(gpsUART0, "Invalid period (1..%u ms): %s\r\n", MAX_PERIOD_MS, ppcArgv[2]);
+          return;
+        }
+        *gasPeriods[i].pu32ms = u32ms;
+      }
+      uart_printf(gpsUART0, "%s period: %u ms\r\n", gasPeriods[i].pcName, *gasPeriods[i].pu32ms);
+      return;
+    }
+  }
+  uart_printf(gpsUART0, "Usage: period <oled|bh1750|log|scan> [ms]\r\n");
+}
+
+static void _cmd_stats(void *pvArg, uint8_t u8Argc, char *const *ppcArgv) {
+  uart_printf(gpsUART0, "UART TX dropped: %u, RX overflow: %u, trace dropped: %u\r\n",
+          gsUartTx.u32Dropped, gsUartRx.u32Overflow, gsTrace.u32Dropped);
+  uart_printf(gpsUART0, "Inc. values: %u %u %u %u\r\n", gau32IncVal[0], gau32IncVal[1], gau32IncVal[2], gau32IncVal[3]);
+}
+
+static void _cmd_scan(void *pvArg, uint8_t u8Argc, char *const *ppcArgv) {
+  gbScanRequest = true;
+}
+
+static void _shell_cycle(uint64_t u64Ticks) {
+  shell_cycle(&gsShell);
+}
+
 static void _schedule_isr() {
   gsPCbDesc.eCpu = xt_utils_get_core_id() ? CPU_APP : CPU_PRO;
   timg_callback_at(gsPCbDesc.u64tckAlarmCur, gsPCbDesc.eCpu, gsPCbDesc.sTimer, gsPCbDesc.u8Int, &_timer_isr, (void*) &gsPCbDesc);
@@ -653,4 +714,5 @@ void prog_cycle_pro(uint64_t u64tckNow) {
   _i2cscan_cycle(u64tckNow);
   _bh1750_cycle(u64tckNow);
   _bme280_cycle(u64tckNow);
+  _shell_cycle(u64tckNow);
 }
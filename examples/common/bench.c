@@ -0,0 +1,49 @@
+/*
+ * Copyright 2025 SZIGETI János
+ *
+ * This file is part of Bilis ESP32 Basic, which is released under GNU General Public License.version 3.
+ * See LICENSE or <https://www.gnu.org/licenses/> for full license details.
+ */
+#ifndef __XTENSA__
+#define _POSIX_C_SOURCE 199309L
+#include <time.h>
+#endif
+#include <stdint.h>
+#include <stdio.h>
+
+#include "xtutils.h"
+#include "bench.h"
+
+// ====================== Interface functions =========================
+
+uint32_t bench_now() {
+#ifdef __XTENSA__
+  return xt_utils_get_cycle_count();
+#else
+  struct timespec sTs;
+  clock_gettime(CLOCK_MONOTONIC, &sTs);
+  return (uint32_t) sTs.tv_sec * 1000000000U + (uint32_t) sTs.tv_nsec;
+#endif
+}
+
+SBenchResult bench_run(const SBenchSuite *psSuite, size_t szIdx, uint32_t u32Reps) {
+  const void *pvCase = (const uint8_t*) psSuite->pvCases + szIdx * psSuite->szCaseSize;
+  SBenchResult sRet = {.pcName = *(const char * const *) pvCase};
+  psSuite->fRun(pvCase, u32Reps, &sRet);
+  sRet.u32CostX100 = sRet.u32Items ? (uint64_t) sRet.u32Elapsed * 100U / sRet.u32Items : 0;
+  return sRet;
+}
+
+int bench_format(char *pcDst, const SBenchSuite *psSuite, const SBenchResult *psRes) {
+  int iLen = snprintf(pcDst, BENCH_LINE_LEN, psSuite->bChecksum ? "%-18s %9lu %08lx" : "%-18s %9lu %5lu",
+          psRes->pcName, (unsigned long) psRes->u32Items,
+          (unsigned long) (psSuite->bChecksum ? psRes->u32Checksum : psRes->u32Mismatches));
+  if (psSuite->pcExtraUnit && iLen < BENCH_LINE_LEN) {
+    iLen += snprintf(pcDst + iLen, BENCH_LINE_LEN - iLen, " %7lu %s", (unsigned long) psRes->u32Extra, psSuite->pcExtraUnit);
+  }
+  if (iLen < BENCH_LINE_LEN) {
+    iLen += snprintf(pcDst + iLen, BENCH_LINE_LEN - iLen, " %7lu.%02lu %s/%s", (unsigned long) psRes->u32CostX100 / 100,
+            (unsigned long) psRes->u32CostX100 % 100, BENCH_UNIT, psSuite->pcItem);
+  }
+  return iLen < BENCH_LINE_LEN ? iLen : BENCH_LINE_LEN - 1;
+}
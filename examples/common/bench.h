@@ -0,0 +1,109 @@
+/*
+ * Copyright 2025 SZIGETI János
+ *
+ * This file is part of Bilis ESP32 Basic, which is released under GNU General Public License.version 3.
+ * See LICENSE or <https://www.gnu.org/licenses/> for full license details.
+ */
+/** @file bench.h
+ * Micro-benchmark harness of the benchmark examples.
+ * An example provides its cases in a table and describes them in gsBenchSuite; the front-ends
+ * run the cases one by one and print one line per case in the same format on both platforms:
+ *  - bench_target.c: ESP32, the results are printed to UART0 after a start delay,
+ *  - bench_host.c: build machine (NATIVE_HOST), the results are printed to stdout.
+ * The time source is the CCOUNT register on ESP32 (CPU cycles) and the monotonic clock on the host (ns).
+ */
+#ifndef BENCH_H
+#define BENCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "typeaux.h"
+
+#ifdef __XTENSA__
+#define BENCH_UNIT "cyc"
+#else
+#define BENCH_UNIT "ns"
+#endif
+
+#define BENCH_LINE_LEN 96U ///< Max. length of a result line (fits into the buffer of uart_printf()).
+
+  /**
+   * Result of a case. The case fills u32Items, u32Elapsed and the checksum / mismatches / extra value.
+   */
+  typedef struct {
+    const char *pcName;      ///< Name of the case.
+    uint32_t u32Items;       ///< Number of processed items.
+    uint32_t u32Checksum;    ///< Checksum of the output (changes only if the output changes).
+    uint32_t u32Mismatches;  ///< Number of items differing from the reference.
+    uint32_t u32Extra;       ///< Suite specific value (see SBenchSuite::pcExtraUnit).
+    uint32_t u32Elapsed;     ///< Time spent in the measured sections (in BENCH_UNIT).
+    uint32_t u32CostX100;    ///< Cost of one item (in BENCH_UNIT) multiplied by 100 (set by bench_run()).
+  } SBenchResult;
+
+  /**
+   * Runs a case of the suite.
+   * @param pvCase Entry of the case table.
+   * @param u32Reps Number of repetitions.
+   * @param psRes Output: result of the case (zero-initialized).
+   */
+  typedef void (*FBenchRun)(const void *pvCase, uint32_t u32Reps, SBenchResult *psRes);
+
+  /**
+   * Descriptor of the benchmark suite of an example.
+   * The case table is an array of the own case type of the example,
+   * the first member of the case type must be its name (const char *pcName).
+   */
+  typedef struct {
+    const void *pvCases;     ///< Case table.
+    size_t szCaseSize;       ///< Size of an entry of the case table.
+    size_t szCases;          ///< Number of cases.
+    FBenchRun fRun;          ///< Runs a case.
+    const char *pcItem;      ///< Name of a processed item (the cost is printed in BENCH_UNIT/pcItem).
+    const char *pcExtraUnit; ///< Unit of the extra value (NULL: the extra value is not printed).
+    bool bChecksum;          ///< The checksum is printed instead of the number of mismatches.
+    uint32_t u32HostReps;    ///< Default number of repetitions on the host.
+    uint32_t u32TargetReps;  ///< Number of repetitions on ESP32.
+  } SBenchSuite;
+
+  /// Initializer of the case table members of SBenchSuite.
+#define BENCH_CASES(A) .pvCases = (A), .szCaseSize = sizeof ((A)[0]), .szCases = ARRAY_SIZE(A)
+
+  /// Benchmark suite of the example (defined by the example).
+  extern const SBenchSuite gsBenchSuite;
+
+  /**
+   * Reads the time source of the benchmark.
+   * Only differences are meaningful, and a single case must not take longer than the wrap-around period.
+   * @return Current time in BENCH_UNIT.
+   */
+  uint32_t bench_now();
+
+  /**
+   * Runs a single case.
+   * @param psSuite Benchmark suite.
+   * @param szIdx Index of the case (0 .. szCases - 1).
+   * @param u32Reps Number of repetitions.
+   * @return Result of the case.
+   */
+  SBenchResult bench_run(const SBenchSuite *psSuite, size_t szIdx, uint32_t u32Reps);
+
+  /**
+   * Formats a result line (without line feed):
+   * name, items, checksum or mismatches, extra value (if any), cost per item.
+   * @param pcDst Destination (BENCH_LINE_LEN bytes).
+   * @param psSuite Benchmark suite.
+   * @param psRes Result of a case.
+   * @return Length of the line.
+   */
+  int bench_format(char *pcDst, const SBenchSuite *psSuite, const SBenchResult *psRes);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BENCH_H */
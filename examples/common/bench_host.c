@@ -0,0 +1,32 @@
+/*
+ * Copyright 2025 SZIGETI János
+ *
+ * This file is part of Bilis ESP32 Basic, which is released under GNU General Public License.version 3.
+ * See LICENSE or <https://www.gnu.org/licenses/> for full license details.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bench.h"
+
+// ====================== Interface functions =========================
+
+/**
+ * Runs all the cases of the suite on the host, the throughput is also printed in items / ms.
+ * Usage: <example> [repetitions]
+ * @return 1, if any of the cases has mismatches.
+ */
+int main(int argc, char **argv) {
+  unsigned long ulReps = (1 < argc) ? strtoul(argv[1], NULL, 0) : gsBenchSuite.u32HostReps;
+  char acLine[BENCH_LINE_LEN];
+  int iRet = 0;
+  for (size_t i = 0; i < gsBenchSuite.szCases; ++i) {
+    SBenchResult sRes = bench_run(&gsBenchSuite, i, ulReps);
+    bench_format(acLine, &gsBenchSuite, &sRes);
+    printf("%s %9lu %s/ms\n", acLine, sRes.u32CostX100 ? 100000000UL / sRes.u32CostX100 : 0UL, gsBenchSuite.pcItem);
+    if (0 != sRes.u32Mismatches) {
+      iRet = 1;
+    }
+  }
+  return iRet;
+}
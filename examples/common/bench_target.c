@@ -0,0 +1,67 @@
+/*
+ * Copyright 2025 SZIGETI János
+ *
+ * This file is part of Bilis ESP32 Basic, which is released under GNU General Public License.version 3.
+ * See LICENSE or <https://www.gnu.org/licenses/> for full license details.
+ */
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "main.h"
+#include "defines.h"
+#include "uart.h"
+#include "bench.h"
+#include "utils/uartutils.h"
+
+// =================== Hard constants =================
+// #1: Timings
+#define UART_FREQ_HZ        115200U
+#define START_DELAY_MS        2000U  ///< give time for the terminal to connect
+#define PRINT_PERIOD_MS         20U  ///< a single result line fits into the UART FIFO
+
+// ================ Local function declarations =================
+static void _bench_cycle(uint64_t u64Ticks);
+
+// =================== Global constants ================
+const bool gbStartAppCpu = START_APP_CPU;
+const uint16_t gu16Tim00Divisor = TIM0_0_DIVISOR;
+const uint64_t gu64tckSchedulePeriod = (CLK_FREQ_HZ / SCHEDULE_FREQ_HZ);
+
+// ==================== Implementation ================
+
+/**
+ * Runs the cases one by one, and prints the result of each case.
+ * @param u64Ticks Current time in ticks.
+ */
+static void _bench_cycle(uint64_t u64Ticks) {
+  static uint64_t u64NextTick = MS2TICKS(START_DELAY_MS);
+  static size_t szIdx = 0;
+
+  if (szIdx < gsBenchSuite.szCases && u64NextTick <= u64Ticks) {
+    char acLine[BENCH_LINE_LEN];
+    SBenchResult sRes = bench_run(&gsBenchSuite, szIdx, gsBenchSuite.u32TargetReps);
+    bench_format(acLine, &gsBenchSuite, &sRes);
+    uart_printf(&gsUART0, "%s\n", acLine);
+    ++szIdx;
+    u64NextTick = u64Ticks + MS2TICKS(PRINT_PERIOD_MS);
+  }
+}
+
+// ====================== Interface functions =========================
+
+void prog_init_pro_pre() {
+  uart_set_baudrate(&gsUART0, APB_FREQ_HZ, UART_FREQ_HZ);
+}
+
+void prog_init_app() {
+}
+
+void prog_init_pro_post() {
+}
+
+void prog_cycle_app(uint64_t u64tckNow) {
+}
+
+void prog_cycle_pro(uint64_t u64tckNow) {
+  _bench_cycle(u64tckNow);
+}
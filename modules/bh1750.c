@@ -24,6 +24,14 @@
 #define BH1750_RES2MLX_MUL    (10000 / 12)
 #define MEASTIME_H_REF_HMS    250U
 #define MEASTIME_L_REF_HMS    36U
+#define MEASTIME_H_MAX_HMS    360U    ///< Max. H / H2 measurement time at BH1750_MTIME_REF (180 ms).
+#define MEASTIME_L_MAX_HMS    48U     ///< Max. L measurement time at BH1750_MTIME_REF (24 ms).
+
+#define BH1750_MTIME_MIN      31U
+#define BH1750_MTIME_MAX      254U
+#define BH1750_COUNT_TARGET   40000U  ///< Auto-ranging aims at this raw count (headroom for rising illuminance).
+#define BH1750_COUNT_LOW      (BH1750_COUNT_TARGET / 4) ///< Auto-ranging keeps the setting down to this raw count ...
+#define BH1750_COUNT_HIGH     60000U  ///< ... and up to this one.
 
 // ================= Internal Types ==================
 
@@ -80,6 +88,8 @@ typedef struct {
 
 // ============ Internal function declarations =================
 static inline EWhatToDo _what_to_do(const BH1750Flags *psFlags);
+static void _autorange(SBh1750StateDesc *psState, uint16_t u16Raw);
+static inline uint32_t _measurementtime_max_hms(uint8_t u8MTime, EBh1750MeasRes eRes);
 
 // ============ Internal function definitions =================
 
@@ -94,8 +104,106 @@ static inline EWhatToDo _what_to_do(const BH1750Flags *psFlags) {
           DO_NOTHING;
 }
 
+/**
+ * Chooses the resolution mode and the MTreg value of the next measurement.
+ * Sensitivity (counts per lx) is proportional to MTreg, and it is doubled in H2 mode,
+ * so the sensitivity giving BH1750_COUNT_TARGET counts is derived from the previous reading.
+ * H2 mode is preferred (better resolution), H mode is used if H2 mode would saturate even with minimal MTreg.
+ * The setting is kept while the reading is within [BH1750_COUNT_LOW, BH1750_COUNT_HIGH],
+ * so small changes of illuminance do not cost MTreg updates.
+ * @param psState Device state (MTreg is updated only if it changes).
+ * @param u16Raw Previous raw reading.
+ */
+static void _autorange(SBh1750StateDesc *psState, uint16_t u16Raw) {
+  EBh1750MeasRes eMRes = bh1750_get_mres(psState);
+  uint8_t u8MTime = bh1750_get_mtime(psState);
+  if (BH1750_COUNT_LOW <= u16Raw && u16Raw <= BH1750_COUNT_HIGH) {
+    bh1750_measure(psState, false, eMRes);
+    return;
+  }
+  uint32_t u32Sens = u8MTime * (eMRes == BH1750_RES_H2 ? 2 : 1);
+  uint32_t u32Want = (UINT16_MAX == u16Raw) ? 0 :
+          (0 == u16Raw) ? UINT32_MAX :
+          (BH1750_COUNT_TARGET * u32Sens) / u16Raw;
+  uint32_t u32MTime;
+
+  if (2 * BH1750_MTIME_MIN <= u32Want) {
+    eMRes = BH1750_RES_H2;
+    u32MTime = u32Want / 2;
+  } else {
+    eMRes = BH1750_RES_H;
+    u32MTime = u32Want;
+  }
+  u32MTime = (u32MTime < BH1750_MTIME_MIN) ? BH1750_MTIME_MIN :
+          (BH1750_MTIME_MAX < u32MTime) ? BH1750_MTIME_MAX :
+          u32MTime;
+  if (u32MTime != u8MTime) {
+    bh1750_set_mtime(psState, u32MTime);
+  }
+  bh1750_measure(psState, false, eMRes);
+}
+
+/**
+ * Calculates the max. measurement time of the datasheet (rounded up).
+ * @param u8MTime MTreg value of the measurement.
+ * @param eRes Measurement resolution.
+ * @return Max. measurement time (unit: 0.5ms).
+ */
+static inline uint32_t _measurementtime_max_hms(uint8_t u8MTime, EBh1750MeasRes eRes) {
+  return (u8MTime * (eRes == BH1750_RES_L ? MEASTIME_L_MAX_HMS : MEASTIME_H_MAX_HMS) + BH1750_MTIME_REF - 1) / BH1750_MTIME_REF;
+}
+
 // ============ Interface function definitions =================
 
+SBh1750Auto bh1750_auto_init(const SI2cIfaceCfg *psIface, FBh1750SampleCallback fSampleCb, void *pvSampleCbParam) {
+  SBh1750Auto sRet = {
+    .sState = bh1750_init_state(),
+    .sIface = *psIface,
+    .fSampleCb = fSampleCb,
+    .pvSampleCbParam = pvSampleCbParam,
+    .u32mLx = 0,
+    .u16Raw = 0,
+    .u8MTime = 0,
+    .eMRes = BH1750_RES_H,
+    .u32Samples = 0,
+    .bInFlight = false
+  };
+  bh1750_set_mtime(&sRet.sState, BH1750_MTIME_MAX);
+  return sRet;
+}
+
+uint32_t bh1750_auto_cycle(SBh1750Auto *psAuto) {
+  SBh1750StateDesc *psState = &psAuto->sState;
+  uint32_t u32hmsWaitHint = 0;
+
+  if (bh1750_async_rx_cycle(psState, &u32hmsWaitHint)) {
+    if (psAuto->bInFlight) {
+      psAuto->u16Raw = conv16be(psState->u16beResult);
+      psAuto->u8MTime = bh1750_get_mtime(psState);
+      psAuto->eMRes = bh1750_get_mres(psState);
+      psAuto->u32mLx = bh1750_result_to_mlx(psAuto->u16Raw, psAuto->u8MTime, psAuto->eMRes);
+      ++psAuto->u32Samples;
+      if (NULL != psAuto->fSampleCb) {
+        psAuto->fSampleCb(psAuto->pvSampleCbParam, psAuto->u32mLx);
+      }
+      _autorange(psState, psAuto->u16Raw);
+    } else {
+      // first measurement: the most sensitive setting
+      bh1750_measure(psState, false, BH1750_RES_H2);
+    }
+    // one-time measurement command wakes the device up, no power on / reset is needed
+    bh1750_read(psState);
+    psAuto->bInFlight = true;
+  } else if (0 != u32hmsWaitHint) {
+    // measurement started: a one-time measurement is read once, so it must not be read before its max. time
+    u32hmsWaitHint = _measurementtime_max_hms(bh1750_get_mtime(psState), bh1750_get_mres(psState));
+  }
+  if (0 == u32hmsWaitHint) {
+    bh1750_async_tx_cycle(&psAuto->sIface, psState);
+  }
+  return u32hmsWaitHint;
+}
+
 SBh1750StateDesc bh1750_init_state() {
   SBh1750StateDesc sRet;
   BH1750Flags *psFlags = (BH1750Flags*) & sRet.u32Flags;
@@ -175,6 +283,58 @@ bool bh1750_is_poweron(const SBh1750StateDesc *psState) {
   return psFlags->eDevState == STATE_PON;
 }
 
+SBh1750Stream bh1750_stream_init(const SI2cIfaceCfg *psIface, EBh1750MeasRes eMRes, uint8_t u8MTime,
+        FBh1750SampleCallback fSampleCb, void *pvSampleCbParam) {
+  SBh1750Stream sRet = {
+    .sState = bh1750_init_state(),
+    .sIface = *psIface,
+    .fSampleCb = fSampleCb,
+    .pvSampleCbParam = pvSampleCbParam,
+    .u32hmsPeriod = bh1750_measurementtime_hms(u8MTime, eMRes),
+    .u32Reads = 0,
+    .u32Samples = 0,
+    .u16Raw = 0,
+    .bReading = false
+  };
+  bh1750_poweron(&sRet.sState);
+  if (BH1750_MTIME_REF != u8MTime) {
+    bh1750_set_mtime(&sRet.sState, u8MTime);
+  }
+  bh1750_measure(&sRet.sState, true, eMRes);
+  return sRet;
+}
+
+uint32_t bh1750_stream_cycle(SBh1750Stream *psStream) {
+  SBh1750StateDesc *psState = &psStream->sState;
+  uint32_t u32hmsWaitHint = 0;
+
+  if (bh1750_async_rx_cycle(psState, &u32hmsWaitHint)) {
+    if (psStream->bReading) {
+      uint16_t u16Raw = conv16be(psState->u16beResult);
+      // the first read follows the first completed conversion (see below), so it is always published
+      if (0 == psStream->u32Reads++ || u16Raw != psStream->u16Raw) {
+        psStream->u16Raw = u16Raw;
+        ++psStream->u32Samples;
+        if (NULL != psStream->fSampleCb) {
+          psStream->fSampleCb(psStream->pvSampleCbParam,
+                  bh1750_result_to_mlx(u16Raw, bh1750_get_mtime(psState), bh1750_get_mres(psState)));
+        }
+      }
+      u32hmsWaitHint = psStream->u32hmsPeriod; // the next result is available one measurement time later
+    } else if (0 != u32hmsWaitHint) {
+      // continuous measurement started: the result register is valid after the first conversion
+      u32hmsWaitHint = _measurementtime_max_hms(bh1750_get_mtime(psState), bh1750_get_mres(psState));
+    }
+    // the read is sent in the first cycle after the wait
+    bh1750_read(psState);
+    psStream->bReading = true;
+  }
+  if (0 == u32hmsWaitHint) {
+    bh1750_async_tx_cycle(&psStream->sIface, psState);
+  }
+  return u32hmsWaitHint;
+}
+
 bool bh1750_async_rx_cycle(SBh1750StateDesc *psState, uint32_t *pu32hmsWaitHint) {
   BH1750Flags *psFlags = (BH1750Flags*) (&psState->u32Flags);
 
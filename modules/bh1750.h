@@ -46,8 +46,89 @@ extern "C" {
     uint16_t u16beResult; ///< Measurement result in Big Endian format
   } SBh1750StateDesc;
 
+  /**
+   * Function type of the sample callback of the auto-ranging driver.
+   */
+  typedef void (*FBh1750SampleCallback)(void *pvParam, uint32_t u32mLx);
+
+  /**
+   * Auto-ranging driver: one-time measurements back-to-back, the resolution mode and MTreg
+   * of the next measurement are chosen from the previous result, so the raw counts stay
+   * in range (no saturation, and no 0 readings in the dark, as long as it is possible).
+   * The range is changed only if the raw count leaves a band around the target count.
+   */
+  typedef struct {
+    SBh1750StateDesc sState;  ///< Device state.
+    SI2cIfaceCfg sIface;      ///< Interface of the device.
+    FBh1750SampleCallback fSampleCb; ///< Invoked for each sample.
+    void *pvSampleCbParam;    ///< First parameter to pass to the callback.
+    uint32_t u32mLx;          ///< Last result.
+    uint16_t u16Raw;          ///< Raw count of the last result.
+    uint8_t u8MTime;          ///< MTreg value of the last result.
+    EBh1750MeasRes eMRes;     ///< Resolution mode of the last result.
+    uint32_t u32Samples;      ///< Number of delivered samples.
+    bool bInFlight;           ///< A measure + read sequence is in progress.
+  } SBh1750Auto;
+
+  /**
+   * Continuous streaming driver: the device is configured once (power on, MTreg, continuous measurement),
+   * afterwards only the 2-byte result is read at the measurement time cadence.
+   * Only the changed values are published.
+   */
+  typedef struct {
+    SBh1750StateDesc sState;  ///< Device state.
+    SI2cIfaceCfg sIface;      ///< Interface of the device.
+    FBh1750SampleCallback fSampleCb; ///< Invoked for each changed sample.
+    void *pvSampleCbParam;    ///< First parameter to pass to the callback.
+    uint32_t u32hmsPeriod;    ///< Read cadence (measurement time, unit: 0.5 ms).
+    uint32_t u32Reads;        ///< Number of reads.
+    uint32_t u32Samples;      ///< Number of published (changed) samples.
+    uint16_t u16Raw;          ///< Raw count of the last read.
+    bool bReading;            ///< A read is queued.
+  } SBh1750Stream;
+
   SBh1750StateDesc bh1750_init_state();
 
+  /**
+   * Initializes the auto-ranging driver (starting with the most sensitive setting).
+   * @param psIface Interface of the device.
+   * @param fSampleCb Callback to invoke for each sample.
+   * @param pvSampleCbParam First parameter to pass to the callback.
+   * @return Initialized driver descriptor.
+   */
+  SBh1750Auto bh1750_auto_init(const SI2cIfaceCfg *psIface, FBh1750SampleCallback fSampleCb, void *pvSampleCbParam);
+
+  /**
+   * Auto-ranging driver cycle: processes the result of the previous transaction, delivers the sample (if any),
+   * chooses the range of the next measurement and starts it.
+   * @param psAuto Driver descriptor.
+   * @return Time to wait before the next call (unit: 0.5ms). After the measurement command
+   * it is the max. measurement time of the datasheet, so the result is never read before the end of the conversion.
+   */
+  uint32_t bh1750_auto_cycle(SBh1750Auto *psAuto);
+
+  /**
+   * Initializes the continuous streaming driver.
+   * @param psIface Interface of the device.
+   * @param eMRes Resolution mode.
+   * @param u8MTime MTreg value.
+   * @param fSampleCb Callback to invoke for each changed sample.
+   * @param pvSampleCbParam First parameter to pass to the callback.
+   * @return Initialized driver descriptor.
+   */
+  SBh1750Stream bh1750_stream_init(const SI2cIfaceCfg *psIface, EBh1750MeasRes eMRes, uint8_t u8MTime,
+          FBh1750SampleCallback fSampleCb, void *pvSampleCbParam);
+
+  /**
+   * Continuous streaming driver cycle: processes the result of the previous transaction,
+   * publishes the sample if it differs from the previous one, and queues the next read.
+   * @param psStream Driver descriptor.
+   * @return Time to wait before the next call (unit: 0.5ms). After the measurement command
+   * it is the max. measurement time of the datasheet, so the first read (always published)
+   * gets the result of a completed conversion.
+   */
+  uint32_t bh1750_stream_cycle(SBh1750Stream *psStream);
+
   // setters
 
   void bh1750_poweron(SBh1750StateDesc *psState);
@@ -23,9 +23,13 @@
 #define MEMLEN_CALIB0 26U
 #define MEMLEN_CALIB1 16U
 #define MEMLEN_DATA 8U
+#define MEMLEN_BURST (MEMADDR_DATA + MEMLEN_DATA - MEMADDR_STATUS) ///< status .. data (0xf3 .. 0xfe)
 
 #define SYM_RESET 0xb6  ///< Reset symbol
 
+#define GROUP_POLL_HMS 1U ///< Status poll interval of a group member converting longer than typical (unit: 0.5 ms).
+#define STREAM_POLL_HMS 1U ///< Read interval of the streaming driver while a conversion is running (unit: 0.5 ms).
+
 // ================= Internal Types ==================
 
 /**
@@ -58,22 +62,6 @@ typedef struct {
   EBme280Tsb eTsb : 3;
 } SConfigBytes;
 
-/**
- * Calibration bytes in a simplified structure (i.e., some attribute types do not match (signed vs. unsigned)).
- */
-typedef struct {
-  int16_t digT[3];
-  int16_t digP[9];
-  uint8_t rsvd24;
-  uint8_t digH1;
-  int16_t digH2;
-  uint8_t digH3; // calib[28]
-  int8_t digH4Msb;
-  uint8_t digH4Lsb : 4;
-  int16_t digH5 : 12;
-  int8_t digH6; // calib[32]
-} SCalib;
-
 /**
  * Handling of dirty/ready bits/bytes is as follows:
  *  0.) if bReset is active
@@ -87,6 +75,7 @@ typedef struct {
  *   2.) [read Calib1] - if not ready
  *   3.) read Status - until updated
  *   4.) read Data
+ *   (3.+4.) with bBurstRead: read Status .. Data in one transaction - until updated
  *  */
 typedef union {
 
@@ -102,7 +91,8 @@ typedef union {
     bool bModeSet : 1;        // triggers chain of state changes until the mode bits get written
     bool bRequestForData : 1; // triggers chain of state changes until data bytes are read out
     bool bReset : 1;          // triggers write to reset register
-    uint32_t rsvd11 : 5;
+    bool bBurstRead : 1;      // status and data bytes are read in a single transaction
+    uint32_t rsvd12 : 4;
     uint8_t u8CurAddr : 8;
     uint8_t u5CurLen : 5;
   };
@@ -116,12 +106,12 @@ typedef union {
 uint32_t gau32hmsStandbyTime[] = {
   5 / 5,
   625 / 5,
-  125000 / 5,
-  250000 / 5,
-  500000 / 5,
-  1000000 / 5,
+  1250 / 5,
+  2500 / 5,
+  5000 / 5,
   10000 / 5,
-  20000 / 5
+  100 / 5,
+  200 / 5
 };
 
 /**
@@ -141,11 +131,12 @@ uint8_t gau8Oversampling[] = {
 // ============ Internal function declarations =================
 static inline uint32_t _tmeasure_hms(const SConfigBytes *psConfig);
 static SBme280TPH _transform_data(const uint8_t *pu8Data);
-static inline int16_t _get_calib_h4(const SCalib *psCalib);
-static int32_t _compensate_T(int32_t i32T, const SCalib *psCalib, uint32_t *t_fine);
-static uint32_t _compensate_P(int32_t i32P, const SCalib *psCalib, uint32_t t_fine);
-static uint32_t _compensate_H(int32_t i32H, const SCalib *psCalib, uint32_t t_fine);
+static inline uint16_t _get_u16le(const uint8_t *pu8Src);
+static int32_t _compensate_T(int32_t i32T, const SBme280Calib *psCalib, uint32_t *t_fine);
+static uint32_t _compensate_H(int32_t i32H, const SBme280Calib *psCalib, uint32_t t_fine);
 static void _set_mode(SBme280StateDesc *psState, EMode eMode);
+static void _data_received(SSyncFlags *psFlags, const SConfigBytes *psConf, uint32_t *pu32hmsWaitHint);
+static void _burst_received(SBme280StateDesc *psState, uint32_t *pu32hmsWaitHint);
 static inline void _write_byte(const SI2cIfaceCfg *psIface, SBme280StateDesc *psState, uint8_t u8MemAddr, uint8_t u8Value);
 static void _write_cfgbyte(const SI2cIfaceCfg *psIface, SBme280StateDesc *psState, uint8_t u8MemAddr);
 static void _read_bytes(const SI2cIfaceCfg *psIface, AsyncResultEntry* psEntry, SBme280StateDesc *psState, uint8_t *pu8Dest, uint8_t u8MemAddr, uint8_t u8MemLen);
@@ -173,68 +164,47 @@ static SBme280TPH _transform_data(const uint8_t *pu8Data) {
 }
 
 /**
- * Calibration attribute dig_H4 is composed of low (4 bits) and high (8 bits) parts.
- * This inline function calculates its value.
- * @param psCalib Full calibration data.
- * @return dig_H4 attribute.
+ * Reads a little-endian 16-bit value of the calibration bytes.
+ * @param pu8Src Address of the low byte.
+ * @return Value.
  */
-static inline int16_t _get_calib_h4(const SCalib *psCalib) {
-  return psCalib->digH4Msb << 4 | psCalib->digH4Lsb;
+static inline uint16_t _get_u16le(const uint8_t *pu8Src) {
+  return pu8Src[0] | (pu8Src[1] << 8);
 }
 
-static int32_t _compensate_T(int32_t i32T, const SCalib *psCalib, uint32_t *pu32TFine) {
+static int32_t _compensate_T(int32_t i32T, const SBme280Calib *psCalib, uint32_t *pu32TFine) {
   int32_t var1, var2, T;
-  int32_t i32ax = (i32T >> 3) - (psCalib->digT[0] << 1);
-  var1 = i32ax * psCalib->digT[1] >> 11;
-  var2 = (((i32ax / 2) * (i32ax / 2)) >> 12) * psCalib->digT[2] >> 14;
+  int32_t i32ax = (i32T >> 4) - psCalib->i32T1;
+  var1 = ((i32T >> 3) - psCalib->i32T1Shl1) * psCalib->i32T2 >> 11;
+  var2 = ((i32ax * i32ax) >> 12) * psCalib->i32T3 >> 14;
   *pu32TFine = var1 + var2;
-  T = (*pu32TFine * 5 + 128) >> 8;
+  T = ((var1 + var2) * 5 + 128) >> 8; // signed: t_fine is negative below 0 °C
   return T;
 }
 
-static uint32_t _compensate_P(int32_t i32P, const SCalib *psCalib, uint32_t u32TFine) {
-  int64_t i64DT = (int64_t) u32TFine - 128000; // diff from 25°C
-  int64_t i64DP = 1048576 - i32P;
-
-  int64_t i64DTPolyA = (i64DT * i64DT * (int64_t) psCalib->digP[2] >> 8)
-          + (i64DT * (int64_t) psCalib->digP[1] << 12)
-          + ((int64_t) 1 << 47);
-  i64DTPolyA *= (uint16_t) psCalib->digP[0];
-  i64DTPolyA >>= 33;
-  int64_t i64DTPolyB = (i64DT * i64DT * (int64_t) psCalib->digP[5])
-          + (i64DT * (int64_t) psCalib->digP[4] << 17)
-          + ((int64_t) psCalib->digP[3] << 35);
-  if (i64DTPolyA == 0) {
-    return 0; // avoid exception caused by division by zero
-  }
-  int64_t i64Px = (((i64DP << 31) - i64DTPolyB) * 3125) / i64DTPolyA;
-  int64_t i64PxPoly = ((int64_t) psCalib->digP[8] * (i64Px >> 13) * (i64Px >> 13) >> 25)
-          + ((int64_t) psCalib->digP[7] * i64Px >> 19)
-          + i64Px;
-  i64PxPoly >>= 8;
-  i64PxPoly += (int64_t) psCalib->digP[6] << 4;
-  return (int32_t) i64PxPoly;
-}
-
-static uint32_t _compensate_H(int32_t i32H, const SCalib *psCalib, uint32_t u32TFine) {
+static uint32_t _compensate_H(int32_t i32H, const SBme280Calib *psCalib, uint32_t u32TFine) {
   int32_t v_x1_u32r;
   v_x1_u32r = u32TFine - (int32_t) 76800; // diff from 15°C
-  v_x1_u32r = (((((i32H << 14) - ((int32_t) _get_calib_h4(psCalib) << 20)
-          - (int32_t) psCalib->digH5 * v_x1_u32r) + (int32_t) 16384) >> 15) * (((((((v_x1_u32r *
-          (int32_t) psCalib->digH6) >> 10) * (((v_x1_u32r * (int32_t) psCalib->digH3) >> 11) +
-          (int32_t) 32768)) >> 10) + (int32_t) 2097152) * (int32_t) psCalib->digH2 +
+  v_x1_u32r = (((((i32H << 14) - psCalib->i32H4Shl20
+          - psCalib->i32H5 * v_x1_u32r) + (int32_t) 16384) >> 15) * (((((((v_x1_u32r *
+          psCalib->i32H6) >> 10) * (((v_x1_u32r * psCalib->i32H3) >> 11) +
+          (int32_t) 32768)) >> 10) + (int32_t) 2097152) * psCalib->i32H2 +
           8192) >> 14));
-  v_x1_u32r = (v_x1_u32r - ((((v_x1_u32r >> 15) * (v_x1_u32r >> 15) >> 7) * (int32_t) psCalib->digH1) >> 4));
+  v_x1_u32r = (v_x1_u32r - ((((v_x1_u32r >> 15) * (v_x1_u32r >> 15) >> 7) * psCalib->i32H1) >> 4));
   v_x1_u32r = (v_x1_u32r < 0 ? 0 : v_x1_u32r);
   v_x1_u32r = (v_x1_u32r > 419430400 ? 419430400 : v_x1_u32r);
   return (uint32_t) (v_x1_u32r >> 12);
 }
 
-static SBme280TPH _compensate(SBme280TPH sRaw, const SCalib *psCalib, uint32_t *pu32TFine) {
+static SBme280TPH _compensate(SBme280TPH sRaw, const SBme280Calib *psCalib, uint32_t *pu32TFine) {
   int32_t i32T = _compensate_T(sRaw.i32Temp, psCalib, pu32TFine); // evaluation of pu32TFine must preceed using of that value in P/H compensation
   return (SBme280TPH){
     i32T,
-    _compensate_P(sRaw.i32Pres, psCalib, *pu32TFine),
+#ifdef BME280_PRES_INT32
+    bme280_compensate_p32(sRaw.i32Pres, psCalib, *pu32TFine),
+#else
+    bme280_compensate_p64(sRaw.i32Pres, psCalib, *pu32TFine),
+#endif
     _compensate_H(sRaw.i32Hum, psCalib, *pu32TFine)};
 }
 
@@ -244,6 +214,41 @@ static void _set_mode(SBme280StateDesc *psState, EMode eMode) {
   ((SSyncFlags*) & psState->u32CommState)->bModeSet = true;
 }
 
+/**
+ * Updates the internal state after the data bytes are received.
+ * @param psFlags Communication state flags.
+ * @param psConf Local configuration.
+ * @param pu32hmsWaitHint Output: suggested wait time before the next TX cycle.
+ */
+static void _data_received(SSyncFlags *psFlags, const SConfigBytes *psConf, uint32_t *pu32hmsWaitHint) {
+  psFlags->bDataUpdated = true;
+  if (psConf->eMode != MODE_NORMAL) {
+    psFlags->bRequestForData = false;
+  } else {
+    *pu32hmsWaitHint = gau32hmsStandbyTime[psConf->eTsb];
+  }
+}
+
+/**
+ * Processes the bytes of a burst read (status .. data).
+ * The data bytes are taken only if no measurement is in progress (in normal mode, the data registers
+ * are shadowed, so they are always consistent).
+ * @param psState Internal state.
+ * @param pu32hmsWaitHint Output: suggested wait time before the next TX cycle.
+ */
+static void _burst_received(SBme280StateDesc *psState, uint32_t *pu32hmsWaitHint) {
+  SSyncFlags *psFlags = (SSyncFlags*) & psState->u32CommState;
+  SConfigBytes *psConf = (SConfigBytes*) psState->au8Config;
+
+  psState->au8Config[MEMADDR_STATUS - MEMADDR_CTRLH] = psState->au8Burst[0];
+  if (psConf->bMeasuring && psConf->eMode != MODE_NORMAL) {
+    return; // status remains dirty
+  }
+  psFlags->bDirtyStatus = false;
+  memcpy(psState->au8Data, psState->au8Burst + (MEMADDR_DATA - MEMADDR_STATUS), MEMLEN_DATA);
+  _data_received(psFlags, psConf, pu32hmsWaitHint);
+}
+
 /**
  * Writes a single byte into a given register on the given slave I2C device,
  * and updates the internal state.
@@ -292,6 +297,139 @@ static void _read_bytes(const SI2cIfaceCfg *psIface, AsyncResultEntry* psEntry,
 
 // ============ Interface function definitions =================
 
+SBme280Stream bme280_stream_init(const SI2cIfaceCfg *psIface, EBme280Osrs eOsrsT, EBme280Osrs eOsrsP, EBme280Osrs eOsrsH,
+        EBme280Tsb eTsb, EBme280Iir eFilter, FBme280SampleCallback fSampleCb, void *pvSampleCbParam) {
+  SBme280Stream sRet = {
+    .sState = bme280_init_state(),
+    .sIface = *psIface,
+    .fSampleCb = fSampleCb,
+    .pvSampleCbParam = pvSampleCbParam,
+    .u32Samples = 0,
+    .bConverting = false
+  };
+  bme280_set_osrs_t(&sRet.sState, eOsrsT);
+  bme280_set_osrs_p(&sRet.sState, eOsrsP);
+  bme280_set_osrs_h(&sRet.sState, eOsrsH);
+  bme280_set_config(&sRet.sState, eTsb, eFilter, false);
+  bme280_set_burst_read(&sRet.sState, true);
+  bme280_set_mode_normal(&sRet.sState);
+  sRet.u32hmsMeasure = _tmeasure_hms((const SConfigBytes*) sRet.sState.au8Config);
+  sRet.u32hmsPeriod = sRet.u32hmsMeasure + gau32hmsStandbyTime[eTsb];
+  return sRet;
+}
+
+uint32_t bme280_stream_cycle(SBme280Stream *psStream) {
+  SBme280StateDesc *psState = &psStream->sState;
+  uint32_t u32hmsWaitHint = 0;
+
+  bme280_async_rx_cycle(psState, &u32hmsWaitHint);
+  if (bme280_is_data_updated(psState)) {
+    // the status byte of the burst tells where the read is in the conversion cycle of the device
+    if (bme280_is_measuring(psState)) {
+      // conversion is running: the data registers are updated at its end
+      bme280_ack_data_updated(psState);
+      psStream->bConverting = true;
+      return STREAM_POLL_HMS;
+    }
+    if (!psStream->bConverting && 0 != psStream->u32Samples) {
+      // read in the standby time (the device is not at the expected phase): the data may have been delivered,
+      // look for the next conversion in steps shorter than a conversion
+      bme280_ack_data_updated(psState);
+      return (1 < psStream->u32hmsMeasure / 2) ? psStream->u32hmsMeasure / 2 : 1;
+    }
+    // a conversion has just ended (or the first one after configuration): new data
+    uint32_t u32TFine;
+    SBme280TPH sResult = bme280_get_measurement(psState, &u32TFine);
+    bme280_ack_data_updated(psState);
+    psStream->bConverting = false;
+    ++psStream->u32Samples;
+    if (NULL != psStream->fSampleCb) {
+      psStream->fSampleCb(psStream->pvSampleCbParam, &sResult, u32TFine);
+    }
+    // the next conversion ends one period later, the next read is due in its middle
+    return psStream->u32hmsPeriod - psStream->u32hmsMeasure / 2;
+  }
+  if (0 == u32hmsWaitHint) {
+    bme280_async_tx_cycle(&psStream->sIface, psState);
+  }
+  return u32hmsWaitHint;
+}
+
+void bme280_group_init(SBme280Group *psGroup, const SI2cIfaceCfg *asIface, uint8_t u8Count,
+        EBme280Osrs eOsrsT, EBme280Osrs eOsrsP, EBme280Osrs eOsrsH, EBme280Iir eFilter,
+        FBme280GroupCallback fSampleCb, void *pvSampleCbParam) {
+  memset(psGroup, 0, sizeof (*psGroup));
+  psGroup->u8Count = (u8Count < BME280_GROUP_MAX) ? u8Count : BME280_GROUP_MAX;
+  psGroup->fSampleCb = fSampleCb;
+  psGroup->pvSampleCbParam = pvSampleCbParam;
+  for (int i = 0; i < psGroup->u8Count; ++i) {
+    SBme280StateDesc *psState = &psGroup->asState[i];
+    psGroup->asIface[i] = asIface[i];
+    *psState = bme280_init_state();
+    bme280_set_osrs_t(psState, eOsrsT);
+    bme280_set_osrs_p(psState, eOsrsP);
+    bme280_set_osrs_h(psState, eOsrsH);
+    bme280_set_config(psState, BME280_TSB_500US, eFilter, false);
+    bme280_set_burst_read(psState, true);
+    bme280_set_mode_forced(psState);
+  }
+}
+
+uint32_t bme280_group_cycle(SBme280Group *psGroup, uint32_t u32hmsNow) {
+  uint8_t u8BusyBuses = 0;
+  uint32_t u32hmsWait = UINT32_MAX;
+
+  // RX: results of the finished transactions
+  for (int i = 0; i < psGroup->u8Count; ++i) {
+    SBme280StateDesc *psState = &psGroup->asState[i];
+    if (0 < (int32_t) (psGroup->au32hmsDue[i] - u32hmsNow)) {
+      continue;
+    }
+    uint32_t u32hmsWaitHint = 0;
+    bool bRx = bme280_async_rx_cycle(psState, &u32hmsWaitHint);
+    if (bme280_is_data_updated(psState)) {
+      uint32_t u32TFine;
+      SBme280TPH sResult = bme280_get_measurement(psState, &u32TFine);
+      bme280_ack_data_updated(psState);
+      bme280_set_mode_forced(psState); // next conversion is triggered by the next TX of this device
+      if (NULL != psGroup->fSampleCb) {
+        psGroup->fSampleCb(psGroup->pvSampleCbParam, i, &sResult, u32TFine);
+      }
+      u32hmsWaitHint = 0;
+    } else if (0 != u32hmsWaitHint) {
+      // conversion is triggered, the hint is its typical duration
+      psGroup->au32hmsConvEnd[i] = u32hmsNow + u32hmsWaitHint;
+    } else if (bRx && bme280_is_measuring(psState)) {
+      // the status says the conversion is still running: wait for its expected end, then poll slowly
+      int32_t i32hmsLeft = (int32_t) (psGroup->au32hmsConvEnd[i] - u32hmsNow);
+      u32hmsWaitHint = ((int32_t) GROUP_POLL_HMS < i32hmsLeft) ? (uint32_t) i32hmsLeft : GROUP_POLL_HMS;
+    }
+    psGroup->au32hmsDue[i] = u32hmsNow + u32hmsWaitHint;
+  }
+
+  // TX: one transaction per bus, round-robin
+  for (int j = 0; j < psGroup->u8Count; ++j) {
+    int i = (psGroup->u8Next + j) % psGroup->u8Count;
+    uint8_t u8BusMask = 1 << psGroup->asIface[i].eBus;
+    if (0 < (int32_t) (psGroup->au32hmsDue[i] - u32hmsNow) || 0 != (u8BusyBuses & u8BusMask)) {
+      continue;
+    }
+    if (bme280_async_tx_cycle(&psGroup->asIface[i], &psGroup->asState[i])) {
+      u8BusyBuses |= u8BusMask;
+      psGroup->u8Next = (i + 1) % psGroup->u8Count;
+    }
+  }
+
+  for (int i = 0; i < psGroup->u8Count; ++i) {
+    int32_t i32hmsLeft = (int32_t) (psGroup->au32hmsDue[i] - u32hmsNow);
+    uint32_t u32hmsLeft = (i32hmsLeft < 0) ? 0 : i32hmsLeft;
+    if (u32hmsLeft < u32hmsWait) {
+      u32hmsWait = u32hmsLeft;
+    }
+  }
+  return (UINT32_MAX == u32hmsWait) ? 0 : u32hmsWait;
+}
+
 SBme280StateDesc bme280_init_state() {
   SBme280StateDesc sRet;
   memset(&sRet, 0, sizeof (sRet));
@@ -351,6 +489,10 @@ bool bme280_get_spi3wen(const SBme280StateDesc *psState) {
   return ((const SConfigBytes*) psState->au8Config)->bSpi3wEn;
 }
 
+void bme280_set_burst_read(SBme280StateDesc *psState, bool bBurstRead) {
+  ((SSyncFlags*) & psState->u32CommState)->bBurstRead = bBurstRead;
+}
+
 bool bme280_is_data_updated(const SBme280StateDesc *psState) {
   return ((const SSyncFlags*) &psState->u32CommState)->bDataUpdated;
 }
@@ -360,13 +502,39 @@ void bme280_ack_data_updated(SBme280StateDesc *psState) {
 }
 
 SBme280TPH bme280_get_measurement(const SBme280StateDesc *psState, uint32_t *pu32TFine) {
-  return bme280_calc_measeurement(psState->au8Data, psState->au8Calib, pu32TFine);
+  return bme280_calc_measurement_cached(psState->au8Data, &psState->sCalib, pu32TFine);
 }
 
 SBme280TPH bme280_calc_measeurement(const uint8_t *pu8Data, const uint8_t *pu8Calib, uint32_t *pu32TFine) {
+  SBme280Calib sCalib = bme280_parse_calib(pu8Calib);
+  return bme280_calc_measurement_cached(pu8Data, &sCalib, pu32TFine);
+}
+
+SBme280Calib bme280_parse_calib(const uint8_t *pu8Calib) {
+  SBme280Calib sRet;
+  sRet.i32T1 = _get_u16le(pu8Calib);
+  sRet.i32T2 = (int16_t) _get_u16le(pu8Calib + 2);
+  sRet.i32T3 = (int16_t) _get_u16le(pu8Calib + 4);
+  sRet.i32T1Shl1 = sRet.i32T1 << 1;
+  sRet.ai32P[0] = _get_u16le(pu8Calib + 6);
+  for (int i = 1; i < 9; ++i) {
+    sRet.ai32P[i] = (int16_t) _get_u16le(pu8Calib + 6 + 2 * i);
+  }
+  sRet.i64P4Shl35 = (int64_t) sRet.ai32P[3] << 35;
+  sRet.i32H1 = pu8Calib[25];
+  sRet.i32H2 = (int16_t) _get_u16le(pu8Calib + 26);
+  sRet.i32H3 = pu8Calib[28];
+  // dig_H4 and dig_H5 are 12-bit signed values sharing the nibbles of calib[30]
+  sRet.i32H4Shl20 = (((int8_t) pu8Calib[29] << 4) | (pu8Calib[30] & 0x0f)) << 20;
+  sRet.i32H5 = ((int8_t) pu8Calib[31] << 4) | (pu8Calib[30] >> 4);
+  sRet.i32H6 = (int8_t) pu8Calib[32];
+  return sRet;
+}
+
+SBme280TPH bme280_calc_measurement_cached(const uint8_t *pu8Data, const SBme280Calib *psCalib, uint32_t *pu32TFine) {
   uint32_t u32TFine;
   SBme280TPH sRaw = _transform_data(pu8Data);
-  SBme280TPH sRet = _compensate(sRaw, (const SCalib*) pu8Calib, &u32TFine);
+  SBme280TPH sRet = _compensate(sRaw, psCalib, &u32TFine);
 
   if (pu32TFine != NULL) {
     *pu32TFine = u32TFine;
@@ -374,6 +542,55 @@ SBme280TPH bme280_calc_measeurement(const uint8_t *pu8Data, const uint8_t *pu8Ca
   return sRet;
 }
 
+uint32_t bme280_compensate_p64(int32_t i32P, const SBme280Calib *psCalib, uint32_t u32TFine) {
+  const int32_t *ai32P = psCalib->ai32P;
+  int64_t i64DT = (int64_t) (int32_t) u32TFine - 128000; // diff from 25°C
+  int64_t i64DP = 1048576 - i32P;
+
+  int64_t i64DTPolyA = (i64DT * i64DT * ai32P[2] >> 8)
+          + (i64DT * ai32P[1] << 12)
+          + ((int64_t) 1 << 47);
+  i64DTPolyA = (i64DTPolyA * ai32P[0]) >> 33;
+  int64_t i64DTPolyB = (i64DT * i64DT * ai32P[5])
+          + (i64DT * ai32P[4] << 17)
+          + psCalib->i64P4Shl35;
+  if (i64DTPolyA == 0) {
+    return 0; // avoid exception caused by division by zero
+  }
+  int64_t i64Px = (((i64DP << 31) - i64DTPolyB) * 3125) / i64DTPolyA;
+  int64_t i64PxPoly = ((ai32P[8] * (i64Px >> 13) * (i64Px >> 13)) >> 25)
+          + ((ai32P[7] * i64Px) >> 19)
+          + i64Px;
+  i64PxPoly >>= 8;
+  i64PxPoly += (int64_t) ai32P[6] << 4;
+  return (uint32_t) i64PxPoly;
+}
+
+uint32_t bme280_compensate_p32(int32_t i32P, const SBme280Calib *psCalib, uint32_t u32TFine) {
+  const int32_t *ai32P = psCalib->ai32P;
+  int32_t var1, var2;
+  uint32_t p;
+  var1 = ((int32_t) u32TFine >> 1) - (int32_t) 64000;
+  var2 = (((var1 >> 2) * (var1 >> 2)) >> 11) * ai32P[5];
+  var2 = var2 + ((var1 * ai32P[4]) << 1);
+  var2 = (var2 >> 2) + (ai32P[3] << 16);
+  var1 = (((ai32P[2] * (((var1 >> 2) * (var1 >> 2)) >> 13)) >> 3) + ((ai32P[1] * var1) >> 1)) >> 18;
+  var1 = ((32768 + var1) * ai32P[0]) >> 15;
+  if (var1 == 0) {
+    return 0; // avoid exception caused by division by zero
+  }
+  p = (((uint32_t) (((int32_t) 1048576) - i32P) - (var2 >> 12))) * 3125;
+  if (p < 0x80000000) {
+    p = (p << 1) / ((uint32_t) var1);
+  } else {
+    p = (p / (uint32_t) var1) * 2;
+  }
+  var1 = (ai32P[8] * ((int32_t) (((p >> 3) * (p >> 3)) >> 13))) >> 12;
+  var2 = (((int32_t) (p >> 2)) * ai32P[7]) >> 13;
+  p = (uint32_t) ((int32_t) p + ((var1 + var2 + ai32P[6]) >> 4));
+  return p << 8;
+}
+
 void bme280_set_mode_forced(SBme280StateDesc *psState) {
   _set_mode(psState, MODE_FORCED);
 }
@@ -394,6 +611,10 @@ bool bme280_is_resetting(const SBme280StateDesc *psState) {
   return ((const SSyncFlags*) & psState->u32CommState)->bReset;
 }
 
+bool bme280_is_measuring(const SBme280StateDesc *psState) {
+  return ((const SConfigBytes*) psState->au8Config)->bMeasuring;
+}
+
 bool bme280_async_rx_cycle(SBme280StateDesc *psState, uint32_t *pu32hmsWaitHint) {
   SSyncFlags *psFlags = (SSyncFlags*) & psState->u32CommState;
   SConfigBytes *psConf = (SConfigBytes*) psState->au8Config;
@@ -426,7 +647,9 @@ bool bme280_async_rx_cycle(SBme280StateDesc *psState, uint32_t *pu32hmsWaitHint)
               }
               break;
             case MEMADDR_STATUS: // read, requires check
-              if (!psConf->bMeasuring) {
+              if (MEMLEN_BURST == psFlags->u5CurLen) {
+                _burst_received(psState, pu32hmsWaitHint);
+              } else if (!psConf->bMeasuring) {
                 psFlags->bDirtyStatus = false;
               }
               break;
@@ -435,14 +658,10 @@ bool bme280_async_rx_cycle(SBme280StateDesc *psState, uint32_t *pu32hmsWaitHint)
               break;
             case MEMADDR_CALIB1: // read
               psFlags->bCalib1Ready = true;
+              psState->sCalib = bme280_parse_calib(psState->au8Calib);
               break;
             case MEMADDR_DATA: // read
-              psFlags->bDataUpdated = true;
-              if (psConf->eMode != MODE_NORMAL) {
-                psFlags->bRequestForData = false;
-              } else {
-                *pu32hmsWaitHint = gau32hmsStandbyTime[psConf->eTsb];
-              }
+              _data_received(psFlags, psConf, pu32hmsWaitHint);
               break;
             default: // unexpected address
               ; // TODO
@@ -495,6 +714,8 @@ bool bme280_async_tx_cycle(const SI2cIfaceCfg *psIface, SBme280StateDesc *psStat
       _read_bytes(psIface, psEntry, psState, psState->au8Calib, MEMADDR_CALIB0, MEMLEN_CALIB0);
     } else if (!psFlags->bCalib1Ready) {
       _read_bytes(psIface, psEntry, psState, psState->au8Calib + MEMLEN_CALIB0, MEMADDR_CALIB1, MEMLEN_CALIB1);
+    } else if (psFlags->bBurstRead && (psFlags->bDirtyStatus || !psFlags->bDataUpdated)) {
+      _read_bytes(psIface, psEntry, psState, psState->au8Burst, MEMADDR_STATUS, MEMLEN_BURST);
     } else if (psFlags->bDirtyStatus) {
       _read_bytes(psIface, psEntry, psState, psState->au8Config + (MEMADDR_STATUS - MEMADDR_CTRLH), MEMADDR_STATUS, 1);
     } else if (!psFlags->bDataUpdated) {
@@ -65,6 +65,26 @@ extern "C" {
     int32_t i32Hum;
   } SBme280TPH;
 
+  /**
+   * Calibration data parsed into a naturally aligned structure, with some derived constants.
+   * Parsing is done once (when the calibration bytes are received), instead of
+   * reinterpreting the raw bytes at each sample.
+   */
+  typedef struct {
+    int32_t i32T1; ///< dig_T1
+    int32_t i32T2; ///< dig_T2
+    int32_t i32T3; ///< dig_T3
+    int32_t i32T1Shl1; ///< dig_T1 << 1
+    int32_t ai32P[9]; ///< dig_P1 .. dig_P9
+    int64_t i64P4Shl35; ///< dig_P4 << 35
+    int32_t i32H1; ///< dig_H1
+    int32_t i32H2; ///< dig_H2
+    int32_t i32H3; ///< dig_H3
+    int32_t i32H4Shl20; ///< dig_H4 << 20
+    int32_t i32H5; ///< dig_H5
+    int32_t i32H6; ///< dig_H6
+  } SBme280Calib;
+
   /**
    * State descriptor of BME280 stub.
    */
@@ -74,11 +94,113 @@ extern "C" {
     uint32_t u32CommState;
     // the following attributes are storing data trasmitted to / received from the target device
     uint8_t au8Calib[42];   ///< bytes at mem 0x88 .. 0xa1, 0xe1 .. 0xf0
+    SBme280Calib sCalib;    ///< parsed calibration data (valid when all the calibration bytes are received)
     uint8_t au8Data[8];     ///< bytes at mem 0xf7 .. 0xfe
     uint8_t au8Config[4];   ///< bytes at mem 0xf2 .. 0xf5
+    uint8_t au8Burst[12];   ///< bytes at mem 0xf3 .. 0xfe (burst read buffer)
   } SBme280StateDesc;
 
+  /**
+   * Function type of the sample callback of the streaming driver.
+   */
+  typedef void (*FBme280SampleCallback)(void *pvParam, const SBme280TPH *psSample, uint32_t u32TFine);
+
+  /**
+   * Streaming driver: the device runs in normal mode (periodic conversions with device-side IIR filtering),
+   * it is configured once, and the data bytes are read at the conversion cadence of the device.
+   * The reads are locked to the end of the conversions (measuring bit of the status byte),
+   * so they do not drift away from the device, whose timing differs from the typical one.
+   */
+  typedef struct {
+    SBme280StateDesc sState;  ///< Device state.
+    SI2cIfaceCfg sIface;      ///< Interface of the device.
+    FBme280SampleCallback fSampleCb; ///< Invoked for each sample.
+    void *pvSampleCbParam;    ///< First parameter to pass to the callback.
+    uint32_t u32hmsMeasure;   ///< Typical conversion time: t_measure (unit: 0.5 ms).
+    uint32_t u32hmsPeriod;    ///< Conversion cadence: t_measure + t_standby (unit: 0.5 ms).
+    uint32_t u32Samples;      ///< Number of delivered samples.
+    bool bConverting;         ///< The last read has found a conversion running.
+  } SBme280Stream;
+
+#define BME280_GROUP_MAX 4U ///< Two addresses (0x76, 0x77) on two buses.
+
+  /**
+   * Function type of the sample callback of the device group.
+   */
+  typedef void (*FBme280GroupCallback)(void *pvParam, uint8_t u8Member, const SBme280TPH *psSample, uint32_t u32TFine);
+
+  /**
+   * Device group: several devices (on one or both buses) measuring in forced mode, with
+   * their transactions interleaved: while a device is converting, the others are
+   * triggered or read out, so the buses are not idle during the conversions.
+   */
+  typedef struct {
+    SBme280StateDesc asState[BME280_GROUP_MAX]; ///< Device states.
+    SI2cIfaceCfg asIface[BME280_GROUP_MAX]; ///< Device interfaces.
+    uint32_t au32hmsDue[BME280_GROUP_MAX]; ///< Time of the next cycle of the devices.
+    uint32_t au32hmsConvEnd[BME280_GROUP_MAX]; ///< Expected end of the last triggered conversion of the devices.
+    uint8_t u8Count;          ///< Number of devices.
+    uint8_t u8Next;           ///< Device to serve first in the next TX round (round-robin).
+    FBme280GroupCallback fSampleCb; ///< Invoked for each sample.
+    void *pvSampleCbParam;    ///< First parameter to pass to the callback.
+  } SBme280Group;
+
   // interface functions
+
+  /**
+   * Initializes the streaming driver.
+   * Configuration (oversampling, standby time, filter, normal mode) is written by the first stream cycles.
+   * @param psIface Interface of the device.
+   * @param eOsrsT Temperature oversampling.
+   * @param eOsrsP Pressure oversampling.
+   * @param eOsrsH Humidity oversampling.
+   * @param eTsb Standby time between conversions.
+   * @param eFilter IIR filter coefficient.
+   * @param fSampleCb Callback to invoke for each sample.
+   * @param pvSampleCbParam First parameter to pass to the callback.
+   * @return Initialized stream descriptor.
+   */
+  SBme280Stream bme280_stream_init(const SI2cIfaceCfg *psIface, EBme280Osrs eOsrsT, EBme280Osrs eOsrsP, EBme280Osrs eOsrsH,
+          EBme280Tsb eTsb, EBme280Iir eFilter, FBme280SampleCallback fSampleCb, void *pvSampleCbParam);
+
+  /**
+   * Stream cycle: processes the result of the previous transaction, delivers the sample (if any),
+   * and starts the next transaction (if the bus is free).
+   * @param psStream Stream descriptor.
+   * @return Time to wait before the next call (unit: 0.5 ms). After a delivered sample the next read
+   * is scheduled to the middle of the next conversion; while a conversion is running, the data is read
+   * again shortly, and the sample is delivered by the first read after its end. A read in the standby time
+   * (the device has drifted away) is followed by reads half a conversion time apart until a conversion is found.
+   */
+  uint32_t bme280_stream_cycle(SBme280Stream *psStream);
+
+  /**
+   * Initializes a device group. Each device is configured the same way.
+   * @param psGroup Group descriptor.
+   * @param asIface Interfaces of the devices (distinct bus / address pairs).
+   * @param u8Count Number of devices (at most BME280_GROUP_MAX).
+   * @param eOsrsT Temperature oversampling.
+   * @param eOsrsP Pressure oversampling.
+   * @param eOsrsH Humidity oversampling.
+   * @param eFilter IIR filter coefficient.
+   * @param fSampleCb Callback to invoke for each sample.
+   * @param pvSampleCbParam First parameter to pass to the callback.
+   */
+  void bme280_group_init(SBme280Group *psGroup, const SI2cIfaceCfg *asIface, uint8_t u8Count,
+          EBme280Osrs eOsrsT, EBme280Osrs eOsrsP, EBme280Osrs eOsrsH, EBme280Iir eFilter,
+          FBme280GroupCallback fSampleCb, void *pvSampleCbParam);
+
+  /**
+   * Group cycle: processes the finished transactions, delivers the samples and re-triggers
+   * the conversion of the devices, then starts at most one transaction per bus
+   * (devices are served in round-robin order).
+   * While a device is converting, its status is read only after the expected end of the conversion.
+   * @param psGroup Group descriptor.
+   * @param u32hmsNow Current time (unit: 0.5 ms, wrap-around is allowed).
+   * @return Time to wait before the next call (unit: 0.5 ms).
+   */
+  uint32_t bme280_group_cycle(SBme280Group *psGroup, uint32_t u32hmsNow);
+
   SBme280StateDesc bme280_init_state();
 
   bool bme280_set_osrs_h(SBme280StateDesc *psState, EBme280Osrs eOsrsH);
@@ -93,17 +215,69 @@ extern "C" {
   EBme280Iir bme280_get_filter(const SBme280StateDesc *psState);
   bool bme280_get_spi3wen(const SBme280StateDesc *psState);
 
+  /**
+   * Enables reading the status and the data bytes in a single I2C transaction.
+   * The measurement is complete, if the status byte of the same transaction says so,
+   * so a forced-mode sample takes a single read transaction instead of (at least) two.
+   * @param psState State descriptor.
+   * @param bBurstRead Burst read enabled.
+   */
+  void bme280_set_burst_read(SBme280StateDesc *psState, bool bBurstRead);
+
   bool bme280_is_data_updated(const SBme280StateDesc *psState);
   void bme280_ack_data_updated(SBme280StateDesc *psState);
   SBme280TPH bme280_get_measurement(const SBme280StateDesc *psState, uint32_t *pu32TFine);
   SBme280TPH bme280_calc_measeurement(const uint8_t *pu8Data, const uint8_t *pu8Calib, uint32_t *pu32TFine);
 
+  /**
+   * Parses the calibration bytes.
+   * @param pu8Calib Calibration bytes (mem 0x88 .. 0xa1, 0xe1 .. 0xf0).
+   * @return Parsed calibration data.
+   */
+  SBme280Calib bme280_parse_calib(const uint8_t *pu8Calib);
+
+  /**
+   * Calculates the compensated measurement values using parsed calibration data.
+   * Pressure compensation is done with bme280_compensate_p64(), or with bme280_compensate_p32(),
+   * if the module is compiled with BME280_PRES_INT32 defined (for targets without fast 64-bit multiplication).
+   * @param pu8Data Data bytes (mem 0xf7 .. 0xfe).
+   * @param psCalib Parsed calibration data.
+   * @param pu32TFine Output (optional): t_fine value.
+   * @return Temperature (0.01 °C), pressure (Pa in Q24.8 format), humidity (%RH in Q22.10 format).
+   */
+  SBme280TPH bme280_calc_measurement_cached(const uint8_t *pu8Data, const SBme280Calib *psCalib, uint32_t *pu32TFine);
+
+  /**
+   * Pressure compensation, 64-bit reference formula of the datasheet.
+   * @param i32P Raw pressure value.
+   * @param psCalib Parsed calibration data.
+   * @param u32TFine t_fine value of the temperature compensation.
+   * @return Pressure (Pa in Q24.8 format).
+   */
+  uint32_t bme280_compensate_p64(int32_t i32P, const SBme280Calib *psCalib, uint32_t u32TFine);
+
+  /**
+   * Pressure compensation, 32-bit formula of the datasheet (integer Pa resolution).
+   * @param i32P Raw pressure value.
+   * @param psCalib Parsed calibration data.
+   * @param u32TFine t_fine value of the temperature compensation.
+   * @return Pressure (Pa in Q24.8 format, the fractional part is 0).
+   */
+  uint32_t bme280_compensate_p32(int32_t i32P, const SBme280Calib *psCalib, uint32_t u32TFine);
+
   void bme280_set_mode_forced(SBme280StateDesc *psState);
   void bme280_set_mode_normal(SBme280StateDesc *psState);
   void bme280_set_mode_sleep(SBme280StateDesc *psState);
   void bme280_reset(SBme280StateDesc *psState);
   bool bme280_is_resetting(const SBme280StateDesc *psState);
 
+  /**
+   * Tells if the last status read says that a conversion is running.
+   * @param psState State descriptor.
+   * @return The measuring bit of the last status byte.
+   */
+  bool bme280_is_measuring(const SBme280StateDesc *psState);
+
   bool bme280_async_rx_cycle(SBme280StateDesc *psState, uint32_t *pu32hmsWaitHint);
   bool bme280_async_tx_cycle(const SI2cIfaceCfg *psIface, SBme280StateDesc *psState);
 
@@ -13,11 +13,12 @@
 
 #define DHT_HOSTPULLDOWN_IVAL_US 1100U  ///< The communication begins with host sending out signal 0 for 1.1 ms.
 
-// measured: [70..73] and [23..27]
-#define DHT_BIT1_IVAL_LO_US 68
-#define DHT_BIT1_IVAL_HI_US 75
-#define DHT_BIT0_IVAL_LO_US 22
-#define DHT_BIT0_IVAL_HI_US 29
+// measured: [70..73] and [23..27]; the 0/1 threshold is learnt from the frame itself (see _bit_threshold()).
+#define DHT_BIT_THRES_US 48         ///< Nominal 0/1 threshold, used when the frame does not contain both bit values.
+#define DHT_BIT_MINGAP_US 20        ///< Pulse width clusters closer than that are considered as one cluster.
+#define DHT_BIT_MAX_US 85           ///< Longer signal 1 pulses are invalid.
+#define DHT_BIT_KMEANS_ROUNDS 4     ///< Upper limit of two-means iterations (it converges in 1-2 rounds on real frames).
+#define DHT_BITS (DHT22_DATA_LEN * 8)
 
 #define DHT22_IDLE_US 90            ///< If the input signal is constant 0 or 1 for more than 90 µs, the RX process is done.
 
@@ -31,14 +32,20 @@
 #define RMTCLK_TO_US(X) (((X) * 1000) / RMT_FREQ_KHZ)
 #endif
 #define RMTDHT_FILTER_THRES 50U     ///< RMT filters out spikes shorter than that many APB clocks.
+#define RMTDHT_MEM_BLOCKS 1U        ///< The received frame (~43 entries) fits into a single RMT RAM block.
 
 // ================ Local function declarations =================
 static inline bool _u16ltz(uint16_t u16Value);
 static inline int16_t _u16abs(uint16_t u16Value);
 static inline int16_t _u16toi16(uint16_t u16Value);
-static void _rmt_config_channel(const ERmtChannel eChannel, uint8_t u8Divisor);
+static bool _rmt_config_channel(const ERmtChannel eChannel, uint8_t u8Divisor);
 static void _rxstart(void *pvParam);
+static uint16_t _bit_threshold(const uint16_t *au16Durations);
 static void _rxready(void *pvParam);
+static inline void _txprepare(SDht22Descriptor *psDht22Desc);
+static void _group_member_ready(void *pvParam, SDht22Data *psData);
+static void _group_round_over(SDht22Group *psGroup);
+static inline uint32_t _group_rxend_bits(const SDht22Group *psGroup);
 // =================== Global constants ================
 
 // ==================== Local Data ================
@@ -58,20 +65,26 @@ static inline int16_t _u16toi16(uint16_t u16Value) {
           u16Value;
 }
 
-static void _rmt_config_channel(ERmtChannel eChannel, uint8_t u8Divisor) {
+static bool _rmt_config_channel(ERmtChannel eChannel, uint8_t u8Divisor) {
+  // the channel config is untouched if the blocks belong to another channel
+  if (!rmt_ram_alloc(eChannel, RMTDHT_MEM_BLOCKS, true)) {
+    return false;
+  }
+
   // rmt channel config
   SRmtChConf rChConf = {
     .r0 =
-    {.u8DivCnt = u8Divisor, .u4MemSize = 1,
+    {.u8DivCnt = u8Divisor, .u4MemSize = RMTDHT_MEM_BLOCKS,
       .u16IdleThres = US_TO_RMTCLK(DHT22_IDLE_US)},
     .r1 =
     {.bRefAlwaysOn = 1, .bRefCntRst = 1, .bMemRdRst = 1,
-      .bIdleOutLvl = 1, .bIdleOutEn = 1,
+      .bIdleOutLvl = 1, .bIdleOutEn = 1, .bMemOwner = 1,
       .bRxFilterEn = 1, .u8RxFilterThres = RMTDHT_FILTER_THRES}
   };
   gpsRMT->asChConf[eChannel] = rChConf;
 
   gpsRMT->arTxLim[eChannel].u9Val = 256; // currently unused
+  return true;
 }
 
 static void _rxstart(void *pvParam) {
@@ -80,33 +93,71 @@ static void _rxstart(void *pvParam) {
 
 }
 
+/**
+ * Learns the 0/1 pulse width threshold from the durations of a frame by splitting them into two clusters (two-means).
+ * @param au16Durations Signal 1 pulse widths of the frame (DHT_BITS items, in µs).
+ * @return Threshold: pulses longer than that are bit 1.
+ */
+static uint16_t _bit_threshold(const uint16_t *au16Durations) {
+  uint16_t u16Min = UINT16_MAX;
+  uint16_t u16Max = 0;
+  for (int i = 0; i < DHT_BITS; ++i) {
+    if (au16Durations[i] < u16Min)
+      u16Min = au16Durations[i];
+    if (u16Max < au16Durations[i])
+      u16Max = au16Durations[i];
+  }
+  if (u16Max < u16Min + DHT_BIT_MINGAP_US) {
+    // single cluster: all the bits have the same value
+    return DHT_BIT_THRES_US;
+  }
+
+  uint16_t u16Thres = (u16Min + u16Max) / 2;
+  for (int r = 0; r < DHT_BIT_KMEANS_ROUNDS; ++r) {
+    uint32_t au32Sum[2] = {0, 0};
+    uint8_t au8Cnt[2] = {0, 0};
+    for (int i = 0; i < DHT_BITS; ++i) {
+      int iCl = (u16Thres < au16Durations[i]);
+      au32Sum[iCl] += au16Durations[i];
+      ++au8Cnt[iCl];
+    }
+    // both clusters are non-empty, as the threshold is between min and max
+    uint16_t u16Next = (au32Sum[0] / au8Cnt[0] + au32Sum[1] / au8Cnt[1]) / 2;
+    if (u16Next == u16Thres)
+      break;
+    u16Thres = u16Next;
+  }
+  return u16Thres;
+}
+
 static void _rxready(void *pvParam) {
   SDht22Descriptor *psParam = (SDht22Descriptor*)pvParam;
-  // Note, here we use _absolute_ RMT RAM addresses.
-  // This works fine since the received data fits into a single RMT RAM block.
-  RegAddr prData = rmt_ram_block(RMT_CH0);
-  uint32_t u32RecvEnd = gpsRMT->asStatus[psParam->eChannel].u9RxIdx;
-  uint32_t u32DataOfs = u32RecvEnd - (DHT22_DATA_LEN * 8) - 1;
-  bool bLowEnd = (prData[u32RecvEnd - 1] & RMT_ENTRYMAX) == 0;
+  // RAM offsets are relative to the first register of the channel (rmt_ram_addr() handles wrap-around).
+  ERmtChannel eCh = psParam->eChannel;
+  uint16_t u16ChLen = RMTDHT_MEM_BLOCKS * RMT_RAM_BLOCK_SIZE;
+  uint16_t u16RecvEnd = rmt_rx_pos(eCh) + u16ChLen;
+  uint16_t u16DataOfs = u16RecvEnd - (DHT22_DATA_LEN * 8) - 1;
+  bool bLowEnd = (*rmt_ram_addr(eCh, RMTDHT_MEM_BLOCKS, u16RecvEnd - 1) & RMT_ENTRYMAX) == 0;
   uint8_t u8Shr = bLowEnd ? 0 : 16;
 
+  uint16_t au16Durations[DHT_BITS];
+  uint64_t u64Levels = 0;
+
   memset(&psParam->sData, 0, sizeof (psParam->sData));
 
-  for (int i = 0; i < (DHT22_DATA_LEN * 8); ++i) {
+  for (int i = 0; i < DHT_BITS; ++i) {
+    uint32_t u32Dat = *rmt_ram_addr(eCh, RMTDHT_MEM_BLOCKS, u16DataOfs + i) >> u8Shr;
+    if (0 != (u32Dat & RMT_SIGNAL1))
+      u64Levels |= (1ULL << i);
+    au16Durations[i] = RMTCLK_TO_US(u32Dat & RMT_ENTRYMAX);
+  }
+  uint16_t u16Thres = _bit_threshold(au16Durations);
+
+  for (int i = 0; i < DHT_BITS; ++i) {
     int iByte = i / 8;
     int iBit = 7 - (i % 8);
-    uint32_t u32Dat = (prData[u32DataOfs + i]) >> u8Shr;
-    bool bLevel0 = (0 != (u32Dat & RMT_SIGNAL1));
-    uint16_t u16Duration0 = RMTCLK_TO_US(u32Dat & RMT_ENTRYMAX);
-    bool bValid = bLevel0;
-    bool bValue = false;
-    if (DHT_BIT0_IVAL_LO_US <= u16Duration0 && u16Duration0 <= DHT_BIT0_IVAL_HI_US) {
-      bValue = false;
-    } else if (DHT_BIT1_IVAL_LO_US <= u16Duration0 && u16Duration0 <= DHT_BIT1_IVAL_HI_US) {
-      bValue = true;
-    } else {
-      bValid = false;
-    }
+    bool bValue = (u16Thres < au16Durations[i]);
+    bool bValid = (0 != (u64Levels & (1ULL << i))) && (au16Durations[i] <= DHT_BIT_MAX_US);
     if (bValue)
       psParam->sData.au8Data[iByte] |= (1 << iBit);
     if (!bValid)
@@ -116,6 +167,65 @@ static void _rxready(void *pvParam) {
   psParam->fReadyCb(psParam->pvReadyCbParam, &psParam->sData);
 }
 
+/**
+ * Puts the host pull-down sequence into the RMT RAM (without starting TX).
+ * @param psDht22Desc DHT22 communication descriptor.
+ */
+static inline void _txprepare(SDht22Descriptor *psDht22Desc) {
+  static const uint32_t u32Tx0 = (RMT_SIGNAL0 | US_TO_RMTCLK(DHT_HOSTPULLDOWN_IVAL_US)) | (RMT_SIGNAL1 << 16);
+
+  SRmtChConf1Reg sConf1 = {.raw = 0};
+  sConf1.bMemOwner = 1;
+  gsRMT.asChConf[psDht22Desc->eChannel].r1.raw |= sConf1.raw;
+
+  rmt_ram_addr(psDht22Desc->eChannel, RMTDHT_MEM_BLOCKS, 0)[0] = u32Tx0;
+}
+
+/**
+ * Member callback of a DHT22 group.
+ * @param pvParam The group.
+ * @param psData Decoded data of a member.
+ */
+static void _group_member_ready(void *pvParam, SDht22Data *psData) {
+  SDht22Group *psGroup = (SDht22Group*) pvParam;
+  for (int i = 0; i < psGroup->u8Count; ++i) {
+    if (&psGroup->asDesc[i].sData == psData) {
+      psGroup->u8PendingMask &= ~(1 << i);
+      psGroup->u8ReadyMask |= (1 << i);
+    }
+  }
+  if (0 == psGroup->u8PendingMask) {
+    _group_round_over(psGroup);
+  }
+}
+
+/**
+ * Invokes the group callback (once per round).
+ * @param psGroup The group.
+ */
+static void _group_round_over(SDht22Group *psGroup) {
+  psGroup->u8PendingMask = 0;
+  if (NULL != psGroup->fReadyCb) {
+    psGroup->fReadyCb(psGroup->pvReadyCbParam, psGroup);
+  }
+  psGroup->u8ReadyMask = 0;
+}
+
+/**
+ * Tells the RXEND interrupt bits of the group members.
+ * The member callbacks (hence the group bookkeeping) run in the RXEND interrupt handlers,
+ * so these bits are masked while the main program updates the group.
+ * @param psGroup The group.
+ * @return Masking value of the RXEND interrupts in the RMT interrupt registers.
+ */
+static inline uint32_t _group_rxend_bits(const SDht22Group *psGroup) {
+  uint32_t u32Ret = 0;
+  for (int i = 0; i < psGroup->u8Count; ++i) {
+    u32Ret |= rmt_int_bit(psGroup->asDesc[i].eChannel, RMT_INT_RXEND);
+  }
+  return u32Ret;
+}
+
 // ============== Interface functions ==============
 
 /**
@@ -123,12 +233,24 @@ static void _rxready(void *pvParam) {
  * @param u8Pin GPIO pin.
  * @param u32ApbClkFreq APB clock frequency.
  * @param psDht22Desc DHT22 communication descriptor.
+ * @return The RMT RAM block could be allocated (otherwise the channel is not initialized).
  */
-void dht22_init(uint8_t u8Pin, uint32_t u32ApbClkFreq, SDht22Descriptor *psDht22Desc) {
+bool dht22_init(uint8_t u8Pin, uint32_t u32ApbClkFreq, SDht22Descriptor *psDht22Desc) {
+  if (!_rmt_config_channel(psDht22Desc->eChannel, u32ApbClkFreq / (1000 * RMT_FREQ_KHZ))) {
+    return false;
+  }
   rmt_init_channel(psDht22Desc->eChannel, u8Pin, false);
-  _rmt_config_channel(psDht22Desc->eChannel, u32ApbClkFreq / (1000 * RMT_FREQ_KHZ));
   rmt_isr_register(psDht22Desc->eChannel, RMT_INT_TXEND, _rxstart, psDht22Desc);
   rmt_isr_register(psDht22Desc->eChannel, RMT_INT_RXEND, _rxready, psDht22Desc);
+  return true;
+}
+
+/**
+ * Releases the RMT RAM block of the DHT22 channel.
+ * @param psDht22Desc DHT22 communication descriptor.
+ */
+void dht22_deinit(SDht22Descriptor *psDht22Desc) {
+  rmt_ram_free(psDht22Desc->eChannel);
 }
 
 /**
@@ -136,15 +258,60 @@ void dht22_init(uint8_t u8Pin, uint32_t u32ApbClkFreq, SDht22Descriptor *psDht22
  * @param psDht22Desc DHT22 communication descriptor.
  */
 void dht22_run(SDht22Descriptor *psDht22Desc) {
-  static const uint32_t u32Tx0 = (RMT_SIGNAL0 | US_TO_RMTCLK(DHT_HOSTPULLDOWN_IVAL_US)) | (RMT_SIGNAL1 << 16);
+  _txprepare(psDht22Desc);
+  rmt_start_tx(psDht22Desc->eChannel, 1);
+}
 
-  SRmtChConf1Reg sConf1 = {.raw = 0};
-  sConf1.bMemOwner = 1;
-  gsRMT.asChConf[psDht22Desc->eChannel].r1.raw |= sConf1.raw;
+/**
+ * Binds DHT22 descriptors into a group.
+ * The members must be on distinct RMT channels, and each of them has to be initialized by dht22_init().
+ * The member callbacks are overridden.
+ * @param psGroup Group descriptor to initialize.
+ * @param asDesc Member descriptors (at most DHT22_GROUP_MAX).
+ * @param u8Count Number of members.
+ * @param fReadyCb Callback to invoke when the data of all members is received.
+ * @param pvReadyCbParam First parameter to pass to the callback.
+ */
+void dht22_group_init(SDht22Group *psGroup, SDht22Descriptor *asDesc, uint8_t u8Count,
+        FDht22GroupCallback fReadyCb, void *pvReadyCbParam) {
+  *psGroup = (SDht22Group){
+    .asDesc = asDesc,
+    .u8Count = (u8Count < DHT22_GROUP_MAX) ? u8Count : DHT22_GROUP_MAX,
+    .u8PendingMask = 0,
+    .u8ReadyMask = 0,
+    .fReadyCb = fReadyCb,
+    .pvReadyCbParam = pvReadyCbParam};
+  for (int i = 0; i < psGroup->u8Count; ++i) {
+    asDesc[i].fReadyCb = _group_member_ready;
+    asDesc[i].pvReadyCbParam = psGroup;
+  }
+}
 
-  rmt_ram_addr(psDht22Desc->eChannel, 1, 0)[0] = u32Tx0;
+/**
+ * Starts a measurement on all the members of the group simultaneously.
+ * If some members have not answered the previous round, the group callback
+ * is invoked first with the partial result (late answers of that round are dropped).
+ * Must not be invoked from RMT interrupt handlers.
+ * @param psGroup Group descriptor.
+ */
+void dht22_group_run(SDht22Group *psGroup) {
+  uint32_t u32RxEndBits = _group_rxend_bits(psGroup);
 
-  rmt_start_tx(psDht22Desc->eChannel, 1);
+  // the member callbacks must not interfere with the bookkeeping
+  gpsRMT->arInt[RMT_INT_ENA] &= ~u32RxEndBits;
+  if (0 != psGroup->u8PendingMask) {
+    _group_round_over(psGroup);
+  }
+  psGroup->u8PendingMask = (1 << psGroup->u8Count) - 1;
+  gpsRMT->arInt[RMT_INT_CLR] = u32RxEndBits;
+  gpsRMT->arInt[RMT_INT_ENA] |= u32RxEndBits;
+
+  for (int i = 0; i < psGroup->u8Count; ++i) {
+    _txprepare(&psGroup->asDesc[i]);
+  }
+  for (int i = 0; i < psGroup->u8Count; ++i) {
+    rmt_start_tx(psGroup->asDesc[i].eChannel, 1);
+  }
 }
 
 /**
@@ -14,6 +14,7 @@ extern "C" {
 #include "rmt.h"
 
 #define DHT22_DATA_LEN 5
+#define DHT22_GROUP_MAX RMT_CHANNEL_NUM ///< Every sensor of a group requires its own RMT channel.
 
   // ============= Types ===============
 
@@ -44,6 +45,30 @@ extern "C" {
     SDht22Data sData;         ///< Store decoded sensor data.
   } SDht22Descriptor;
 
+  struct SDht22Group;
+
+  /**
+   * Function type of the group callback that gets invoked, when all the sensors of
+   * the group have sent their data, or when a new measurement is started while
+   * some sensors have not answered the previous one.
+   * The u8ReadyMask attribute of the group tells which members have valid sData.
+   */
+  typedef void (*FDht22GroupCallback)(void *pvParam, struct SDht22Group *psGroup);
+
+  /**
+   * Group of DHT22 sensors (on distinct RMT channels) measured in the same time window.
+   * The masks are updated by the RXEND interrupt handlers of the members,
+   * and by dht22_group_run() while those interrupts are masked.
+   */
+  typedef struct SDht22Group {
+    SDht22Descriptor *asDesc;       ///< Member descriptors.
+    uint8_t u8Count;                ///< Number of members.
+    volatile uint8_t u8PendingMask; ///< Members (bit index) whose data is still not received.
+    volatile uint8_t u8ReadyMask;   ///< Members (bit index) whose data is received in the current round.
+    FDht22GroupCallback fReadyCb;   ///< Callback to invoke when the round is over.
+    void *pvReadyCbParam;           ///< First parameter to pass to the callback function.
+  } SDht22Group;
+
   // ============= Inline functions ===============
 
   /**
@@ -60,11 +85,15 @@ extern "C" {
 
 
   // ============= Interface function declaration ===============
-  void dht22_init(uint8_t u8Pin, uint32_t u32ApbClkFreq, SDht22Descriptor *psDht22Desc);
+  bool dht22_init(uint8_t u8Pin, uint32_t u32ApbClkFreq, SDht22Descriptor *psDht22Desc);
+  void dht22_deinit(SDht22Descriptor *psDht22Desc);
   void dht22_run(SDht22Descriptor *psDht22Desc);
   uint16_t dht22_get_rhum(const SDht22Data *psData);
   int16_t dht22_get_temp(const SDht22Data *psData);
   bool dht22_data_valid(const SDht22Data *psData);
+  void dht22_group_init(SDht22Group *psGroup, SDht22Descriptor *asDesc, uint8_t u8Count,
+          FDht22GroupCallback fReadyCb, void *pvReadyCbParam);
+  void dht22_group_run(SDht22Group *psGroup);
 
 
 #ifdef __cplusplus
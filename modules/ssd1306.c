@@ -0,0 +1,232 @@
+/*
+ * Copyright 2025 SZIGETI János
+ *
+ * This file is part of Bilis ESP32 Basic, which is released under GNU General Public License.version 3.
+ * See LICENSE or <https://www.gnu.org/licenses/> for full license details.
+ */
+
+#include <stdbool.h>
+#include <string.h>
+#include "ssd1306.h"
+
+// control bytes
+#define SSD1306_CTRL_CMD      0x00
+#define SSD1306_CTRL_DATA     0x40
+// commands
+#define SSD1306_CMD_COLADDR   0x21
+#define SSD1306_CMD_PAGEADDR  0x22
+
+// ================ Local function declarations =================
+static inline uint32_t _burst_cost(uint32_t u32Bytes);
+static inline uint16_t _window_len(const SSsd1306StateDesc *psState);
+static bool _take_window(SSsd1306StateDesc *psState);
+
+// =================== Global constants ================
+
+static const uint8_t gau8InitSeq[] = {
+  SSD1306_CTRL_CMD, // command sequence begins
+  0xA8, 0x3F, 0xD3, 0x00, // Set MUX ratio, Set display offset
+  0x40, 0x20, 0x00, 0xA0, // Set display start line, Horizontal addressing mode, Set segment re-map
+  0xC0, 0xDA, 0x02, // Set COM Output scan direction, Set COM pins hw config
+  0x81, 0x0F, // Set contrast ctrl
+  0xA4, 0xA6, // Disable entire display ON, Set normal display,
+  0xD5, 0x80, 0x8D, 0x14, // Set OSC frequency, Enable charge pump regulator
+  0xAF // Display on
+};
+
+// ==================== Implementation ================
+
+/**
+ * Number of transactions needed to send a window.
+ * @param u32Bytes Size of the window.
+ * @return Window command + data bursts.
+ */
+static inline uint32_t _burst_cost(uint32_t u32Bytes) {
+  return 1 + (u32Bytes + SSD1306_BURST_LEN - 1) / SSD1306_BURST_LEN;
+}
+
+static inline uint16_t _window_len(const SSsd1306StateDesc *psState) {
+  return (psState->u8WinPage1 - psState->u8WinPage0 + 1) * (psState->u8WinCol1 - psState->u8WinCol0 + 1);
+}
+
+/**
+ * Chooses the next window to send and takes the dirty spans it covers.
+ * The window is the bounding rectangle of all dirty spans, if sending it does not need more transactions
+ * than sending the spans page by page; otherwise the dirty span of the first dirty page.
+ * @param psState Ptr. to SSD1306 state descriptor.
+ * @return There was a dirty span.
+ */
+static bool _take_window(SSsd1306StateDesc *psState) {
+  uint8_t u8Page0 = SSD1306_PAGES;
+  uint8_t u8Page1 = 0;
+  uint8_t u8Col0 = SSD1306_WIDTH;
+  uint8_t u8Col1 = 0;
+  uint32_t u32PageCost = 0;
+
+  for (uint8_t i = 0; i < SSD1306_PAGES; ++i) {
+    if (psState->au8DirtyBegin[i] < psState->au8DirtyEnd[i]) {
+      if (u8Page0 == SSD1306_PAGES) {
+        u8Page0 = i;
+      }
+      u8Page1 = i;
+      if (psState->au8DirtyBegin[i] < u8Col0) u8Col0 = psState->au8DirtyBegin[i];
+      if (u8Col1 < psState->au8DirtyEnd[i]) u8Col1 = psState->au8DirtyEnd[i];
+      u32PageCost += _burst_cost(psState->au8DirtyEnd[i] - psState->au8DirtyBegin[i]);
+    }
+  }
+  if (u8Page0 == SSD1306_PAGES) {
+    return false;
+  }
+  if (u32PageCost < _burst_cost((u8Page1 - u8Page0 + 1) * (u8Col1 - u8Col0))) {
+    u8Page1 = u8Page0;
+    u8Col0 = psState->au8DirtyBegin[u8Page0];
+    u8Col1 = psState->au8DirtyEnd[u8Page0];
+  }
+  for (uint8_t i = u8Page0; i <= u8Page1; ++i) {
+    psState->au8DirtyBegin[i] = SSD1306_WIDTH;
+    psState->au8DirtyEnd[i] = 0;
+  }
+  psState->u8WinPage0 = u8Page0;
+  psState->u8WinPage1 = u8Page1;
+  psState->u8WinCol0 = u8Col0;
+  psState->u8WinCol1 = u8Col1 - 1;
+  psState->u16SentLen = 0;
+  psState->bWinActive = true;
+  psState->bWinSet = false;
+  return true;
+}
+
+// ==================== Interface functions ================
+
+SSsd1306StateDesc ssd1306_init_state() {
+  SSsd1306StateDesc sRet;
+  memset(&sRet, 0, sizeof (sRet));
+  ssd1306_fill(&sRet, 0);
+  return sRet;
+}
+
+void ssd1306_mark_dirty(SSsd1306StateDesc *psState, uint8_t u8Page, uint8_t u8Col0, uint8_t u8Col1) {
+  if (SSD1306_PAGES <= u8Page) return;
+  if (SSD1306_WIDTH < u8Col1) u8Col1 = SSD1306_WIDTH;
+  if (u8Col1 <= u8Col0) return;
+  if (u8Col0 < psState->au8DirtyBegin[u8Page]) psState->au8DirtyBegin[u8Page] = u8Col0;
+  if (psState->au8DirtyEnd[u8Page] < u8Col1) psState->au8DirtyEnd[u8Page] = u8Col1;
+}
+
+void ssd1306_fill(SSsd1306StateDesc *psState, uint8_t u8Pattern) {
+  memset(psState->au8Fb, u8Pattern, sizeof (psState->au8Fb));
+  for (uint8_t i = 0; i < SSD1306_PAGES; ++i) {
+    psState->au8DirtyBegin[i] = 0;
+    psState->au8DirtyEnd[i] = SSD1306_WIDTH;
+  }
+}
+
+void ssd1306_set_byte(SSsd1306StateDesc *psState, uint8_t u8Page, uint8_t u8Col, uint8_t u8Value) {
+  if (SSD1306_PAGES <= u8Page || SSD1306_WIDTH <= u8Col) return;
+  if (psState->au8Fb[u8Page][u8Col] != u8Value) {
+    psState->au8Fb[u8Page][u8Col] = u8Value;
+    ssd1306_mark_dirty(psState, u8Page, u8Col, u8Col + 1);
+  }
+}
+
+void ssd1306_set_column(SSsd1306StateDesc *psState, uint8_t u8Col, uint32_t u32Pixels) {
+  for (uint8_t i = 0; i < SSD1306_PAGES; ++i) {
+    ssd1306_set_byte(psState, i, u8Col, (uint8_t) (u32Pixels >> (8 * i)));
+  }
+}
+
+void ssd1306_set_pixel(SSsd1306StateDesc *psState, uint8_t u8X, uint8_t u8Y, bool bOn) {
+  if (SSD1306_WIDTH <= u8X || SSD1306_HEIGHT <= u8Y) return;
+  uint8_t u8Page = u8Y / 8;
+  uint8_t u8Mask = 1 << (u8Y % 8);
+  uint8_t u8Value = psState->au8Fb[u8Page][u8X];
+  ssd1306_set_byte(psState, u8Page, u8X, bOn ? (u8Value | u8Mask) : (u8Value & ~u8Mask));
+}
+
+bool ssd1306_is_flushed(const SSsd1306StateDesc *psState) {
+  if (!psState->bInitDone || psState->bWinActive || psState->bWaitingForRx) {
+    return false;
+  }
+  for (uint8_t i = 0; i < SSD1306_PAGES; ++i) {
+    if (psState->au8DirtyBegin[i] < psState->au8DirtyEnd[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ssd1306_async_rx_cycle(SSsd1306StateDesc *psState) {
+  if (psState->bWaitingForRx) {
+    AsyncResultEntry* psEntry = lockmgr_get_entry(psState->u32LastLabel);
+    if (psEntry) {
+      if (psEntry->bReady) {
+        if (!(psEntry->u32IntSt & I2C_INT_MASK_ERR)) {
+          ++psState->u32Transactions;
+          if (!psState->bInitDone) {
+            psState->bInitDone = true;
+          } else if (!psState->bWinSet) {
+            psState->bWinSet = true;
+          } else {
+            psState->u16SentLen += psState->u8TxLen;
+            if (_window_len(psState) <= psState->u16SentLen) {
+              psState->bWinActive = false;
+            }
+          }
+        } else if (psState->bWinActive) {
+          // the address pointer of the device is unknown: resend the whole window
+          for (uint8_t i = psState->u8WinPage0; i <= psState->u8WinPage1; ++i) {
+            ssd1306_mark_dirty(psState, i, psState->u8WinCol0, psState->u8WinCol1 + 1);
+          }
+          psState->bWinActive = false;
+        }
+        lockmgr_release_entry(psState->u32LastLabel);
+        psState->bWaitingForRx = false;
+      } else { // still waiting for i2c bus to be ready
+        return false;
+      }
+    } else {
+      // TODO: error, no lockmgr entry found
+    }
+  }
+  return ssd1306_is_flushed(psState);
+}
+
+bool ssd1306_async_tx_cycle(const SI2cIfaceCfg *psIface, SSsd1306StateDesc *psState) {
+  uint8_t au8Buf[1 + SSD1306_BURST_LEN];
+
+  if (psState->bWaitingForRx) return false;
+  if (psState->bInitDone && !psState->bWinActive && !_take_window(psState)) return false;
+  if (!lockmgr_acquire_lock(psIface->eLck, &psState->u32LastLabel)) return false;
+
+  if (!psState->bInitDone) {
+    i2c_write(psIface->eBus, psIface->u8SlaveAddr, sizeof (gau8InitSeq), gau8InitSeq);
+  } else if (!psState->bWinSet) {
+    au8Buf[0] = SSD1306_CTRL_CMD;
+    au8Buf[1] = SSD1306_CMD_COLADDR;
+    au8Buf[2] = psState->u8WinCol0;
+    au8Buf[3] = psState->u8WinCol1;
+    au8Buf[4] = SSD1306_CMD_PAGEADDR;
+    au8Buf[5] = psState->u8WinPage0;
+    au8Buf[6] = psState->u8WinPage1;
+    i2c_write(psIface->eBus, psIface->u8SlaveAddr, 7, au8Buf);
+  } else {
+    uint8_t u8Width = psState->u8WinCol1 - psState->u8WinCol0 + 1;
+    uint16_t u16Remaining = _window_len(psState) - psState->u16SentLen;
+    uint8_t u8Page = psState->u8WinPage0 + psState->u16SentLen / u8Width;
+    uint8_t u8Col = psState->u8WinCol0 + psState->u16SentLen % u8Width;
+
+    uint8_t u8Len = u16Remaining < SSD1306_BURST_LEN ? u16Remaining : SSD1306_BURST_LEN;
+    au8Buf[0] = SSD1306_CTRL_DATA;
+    for (uint8_t i = 1; i <= u8Len; ++i) {
+      au8Buf[i] = psState->au8Fb[u8Page][u8Col];
+      if (psState->u8WinCol1 < ++u8Col) {
+        u8Col = psState->u8WinCol0;
+        ++u8Page;
+      }
+    }
+    psState->u8TxLen = u8Len;
+    i2c_write(psIface->eBus, psIface->u8SlaveAddr, 1 + u8Len, au8Buf);
+  }
+  psState->bWaitingForRx = true;
+  return true;
+}
@@ -0,0 +1,134 @@
+/*
+ * Copyright 2025 SZIGETI János
+ *
+ * This file is part of Bilis ESP32 Basic, which is released under GNU General Public License.version 3.
+ * See LICENSE or <https://www.gnu.org/licenses/> for full license details.
+ */
+/** @file ssd1306.h
+ * SSD1306 OLED driver (I2C) with in-RAM framebuffer.
+ * Drawing functions modify only the framebuffer and mark the modified column spans of the pages dirty.
+ * The asynchronous cycle functions send only the dirty spans: an address window command and
+ * data bursts of SSD1306_BURST_LEN bytes (the longest one that fits into the I2C FIFO).
+ * If it is cheaper, the bounding rectangle of the dirty spans of several pages is sent in one window.
+ */
+#ifndef SSD1306_H
+#define SSD1306_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "utils/i2ciface.h"
+
+#define SSD1306_WIDTH 128U     ///< Number of columns.
+#define SSD1306_PAGES 4U       ///< Number of pages (8 pixel rows each).
+#define SSD1306_HEIGHT (8U * SSD1306_PAGES)
+#define SSD1306_BURST_LEN 30U  ///< Max. number of data bytes in a transaction (FIFO: address + control byte + data).
+
+  /**
+   * State descriptor of the SSD1306 device.
+   * Framebuffer layout follows the horizontal addressing mode of the device:
+   * au8Fb[page][column], bit n of a byte is the row 8 * page + n.
+   */
+  typedef struct {
+    uint8_t au8Fb[SSD1306_PAGES][SSD1306_WIDTH]; ///< Framebuffer.
+    uint8_t au8DirtyBegin[SSD1306_PAGES]; ///< First dirty column of the pages (SSD1306_WIDTH if the page is clean).
+    uint8_t au8DirtyEnd[SSD1306_PAGES];   ///< End (last + 1) of the dirty column span of the pages.
+    uint32_t u32LastLabel;
+    uint16_t u16SentLen;      ///< Number of data bytes of the current window already sent.
+    uint8_t u8WinPage0;       ///< First page of the current window.
+    uint8_t u8WinPage1;       ///< Last page of the current window.
+    uint8_t u8WinCol0;        ///< First column of the current window.
+    uint8_t u8WinCol1;        ///< Last column of the current window.
+    uint8_t u8TxLen;          ///< Number of data bytes in the pending transaction (0: window command).
+    bool bInitDone;           ///< Init sequence is sent.
+    bool bWinActive;          ///< Window is chosen (its dirty spans are taken).
+    bool bWinSet;             ///< Window command is sent.
+    bool bWaitingForRx;
+    uint32_t u32Transactions; ///< Number of successful transactions (statistics).
+  } SSsd1306StateDesc;
+
+  /**
+   * Initializes the state descriptor: the framebuffer is cleared and all of it is marked dirty,
+   * so the first flush (after the init sequence) clears the display.
+   * @return Initialized state descriptor.
+   */
+  SSsd1306StateDesc ssd1306_init_state();
+
+  // drawing
+
+  /**
+   * Marks a column span of a page dirty (use it after modifying au8Fb directly).
+   * @param psState Ptr. to SSD1306 state descriptor.
+   * @param u8Page Page index.
+   * @param u8Col0 First column.
+   * @param u8Col1 End of the span (last column + 1).
+   */
+  void ssd1306_mark_dirty(SSsd1306StateDesc *psState, uint8_t u8Page, uint8_t u8Col0, uint8_t u8Col1);
+
+  /**
+   * Fills the whole framebuffer.
+   * @param psState Ptr. to SSD1306 state descriptor.
+   * @param u8Pattern Byte to write into each column of each page.
+   */
+  void ssd1306_fill(SSsd1306StateDesc *psState, uint8_t u8Pattern);
+
+  static inline void ssd1306_clear(SSsd1306StateDesc *psState) {
+    ssd1306_fill(psState, 0);
+  }
+
+  /**
+   * Writes a byte of the framebuffer (marks it dirty only if it changes).
+   * @param psState Ptr. to SSD1306 state descriptor.
+   * @param u8Page Page index.
+   * @param u8Col Column index.
+   * @param u8Value 8 vertical pixels (LSB is the top one).
+   */
+  void ssd1306_set_byte(SSsd1306StateDesc *psState, uint8_t u8Page, uint8_t u8Col, uint8_t u8Value);
+
+  /**
+   * Writes a full column (all pages) of the framebuffer.
+   * @param psState Ptr. to SSD1306 state descriptor.
+   * @param u8Col Column index.
+   * @param u32Pixels Pixels of the column (bit n is row n).
+   */
+  void ssd1306_set_column(SSsd1306StateDesc *psState, uint8_t u8Col, uint32_t u32Pixels);
+
+  /**
+   * Sets / clears a pixel.
+   * @param psState Ptr. to SSD1306 state descriptor.
+   * @param u8X Column.
+   * @param u8Y Row.
+   * @param bOn Pixel value.
+   */
+  void ssd1306_set_pixel(SSsd1306StateDesc *psState, uint8_t u8X, uint8_t u8Y, bool bOn);
+
+  /**
+   * @param psState Ptr. to SSD1306 state descriptor.
+   * @return There is nothing to send (init sequence is sent, no dirty spans left).
+   */
+  bool ssd1306_is_flushed(const SSsd1306StateDesc *psState);
+
+  /**
+   * Receiver side of asynchronous communication.
+   * On error, the current window is marked dirty again (and resent from the beginning).
+   * @param psState Ptr. to SSD1306 state descriptor.
+   * @return The framebuffer is flushed (nothing to send).
+   */
+  bool ssd1306_async_rx_cycle(SSsd1306StateDesc *psState);
+
+  /**
+   * Transmitter side of asynchronous communication: sends the init sequence, a window command or a data burst.
+   * @param psIface Interface of the device.
+   * @param psState Ptr. to SSD1306 state descriptor.
+   * @return A transaction is started.
+   */
+  bool ssd1306_async_tx_cycle(const SI2cIfaceCfg *psIface, SSsd1306StateDesc *psState);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SSD1306_H */
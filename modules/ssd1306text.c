@@ -0,0 +1,189 @@
+/*
+ * Copyright 2025 SZIGETI János
+ *
+ * This file is part of Bilis ESP32 Basic, which is released under GNU General Public License.version 3.
+ * See LICENSE or <https://www.gnu.org/licenses/> for full license details.
+ */
+
+#include <stdbool.h>
+#include <string.h>
+#include "ssd1306text.h"
+
+// ================ Local function declarations =================
+static void _blit(SSsd1306StateDesc *psState, uint8_t u8Page, uint8_t u8X, const uint8_t *pu8Src, uint8_t u8Len);
+
+// =================== Global constants ================
+
+/**
+ * 5x7 font, characters 0x20 .. 0x7F. Columns from left to right, LSB is the top row.
+ */
+static const uint8_t gau8Font[SSD1306TEXT_LAST - SSD1306TEXT_FIRST + 1][SSD1306TEXT_ADVANCE] = {
+  {0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // ' '
+  {0x00, 0x00, 0x5F, 0x00, 0x00, 0x00}, // '!'
+  {0x00, 0x07, 0x00, 0x07, 0x00, 0x00}, // '"'
+  {0x14, 0x7F, 0x14, 0x7F, 0x14, 0x00}, // '#'
+  {0x24, 0x2A, 0x7F, 0x2A, 0x12, 0x00}, // '$'
+  {0x23, 0x13, 0x08, 0x64, 0x62, 0x00}, // '%'
+  {0x36, 0x49, 0x55, 0x22, 0x50, 0x00}, // '&'
+  {0x00, 0x05, 0x03, 0x00, 0x00, 0x00}, // '''
+  {0x00, 0x1C, 0x22, 0x41, 0x00, 0x00}, // '('
+  {0x00, 0x41, 0x22, 0x1C, 0x00, 0x00}, // ')'
+  {0x08, 0x2A, 0x1C, 0x2A, 0x08, 0x00}, // '*'
+  {0x08, 0x08, 0x3E, 0x08, 0x08, 0x00}, // '+'
+  {0x00, 0x50, 0x30, 0x00, 0x00, 0x00}, // ','
+  {0x08, 0x08, 0x08, 0x08, 0x08, 0x00}, // '-'
+  {0x00, 0x60, 0x60, 0x00, 0x00, 0x00}, // '.'
+  {0x20, 0x10, 0x08, 0x04, 0x02, 0x00}, // '/'
+  {0x3E, 0x51, 0x49, 0x45, 0x3E, 0x00}, // '0'
+  {0x00, 0x42, 0x7F, 0x40, 0x00, 0x00}, // '1'
+  {0x42, 0x61, 0x51, 0x49, 0x46, 0x00}, // '2'
+  {0x21, 0x41, 0x45, 0x4B, 0x31, 0x00}, // '3'
+  {0x18, 0x14, 0x12, 0x7F, 0x10, 0x00}, // '4'
+  {0x27, 0x45, 0x45, 0x45, 0x39, 0x00}, // '5'
+  {0x3C, 0x4A, 0x49, 0x49, 0x30, 0x00}, // '6'
+  {0x01, 0x71, 0x09, 0x05, 0x03, 0x00}, // '7'
+  {0x36, 0x49, 0x49, 0x49, 0x36, 0x00}, // '8'
+  {0x06, 0x49, 0x49, 0x29, 0x1E, 0x00}, // '9'
+  {0x00, 0x36, 0x36, 0x00, 0x00, 0x00}, // ':'
+  {0x00, 0x56, 0x36, 0x00, 0x00, 0x00}, // ';'
+  {0x08, 0x14, 0x22, 0x41, 0x00, 0x00}, // '<'
+  {0x14, 0x14, 0x14, 0x14, 0x14, 0x00}, // '='
+  {0x00, 0x41, 0x22, 0x14, 0x08, 0x00}, // '>'
+  {0x02, 0x01, 0x51, 0x09, 0x06, 0x00}, // '?'
+  {0x32, 0x49, 0x79, 0x41, 0x3E, 0x00}, // '@'
+  {0x7E, 0x11, 0x11, 0x11, 0x7E, 0x00}, // 'A'
+  {0x7F, 0x49, 0x49, 0x49, 0x36, 0x00}, // 'B'
+  {0x3E, 0x41, 0x41, 0x41, 0x22, 0x00}, // 'C'
+  {0x7F, 0x41, 0x41, 0x22, 0x1C, 0x00}, // 'D'
+  {0x7F, 0x49, 0x49, 0x49, 0x41, 0x00}, // 'E'
+  {0x7F, 0x09, 0x09, 0x09, 0x01, 0x00}, // 'F'
+  {0x3E, 0x41, 0x49, 0x49, 0x7A, 0x00}, // 'G'
+  {0x7F, 0x08, 0x08, 0x08, 0x7F, 0x00}, // 'H'
+  {0x00, 0x41, 0x7F, 0x41, 0x00, 0x00}, // 'I'
+  {0x20, 0x40, 0x41, 0x3F, 0x01, 0x00}, // 'J'
+  {0x7F, 0x08, 0x14, 0x22, 0x41, 0x00}, // 'K'
+  {0x7F, 0x40, 0x40, 0x40, 0x40, 0x00}, // 'L'
+  {0x7F, 0x02, 0x0C, 0x02, 0x7F, 0x00}, // 'M'
+  {0x7F, 0x04, 0x08, 0x10, 0x7F, 0x00}, // 'N'
+  {0x3E, 0x41, 0x41, 0x41, 0x3E, 0x00}, // 'O'
+  {0x7F, 0x09, 0x09, 0x09, 0x06, 0x00}, // 'P'
+  {0x3E, 0x41, 0x51, 0x21, 0x5E, 0x00}, // 'Q'
+  {0x7F, 0x09, 0x19, 0x29, 0x46, 0x00}, // 'R'
+  {0x46, 0x49, 0x49, 0x49, 0x31, 0x00}, // 'S'
+  {0x01, 0x01, 0x7F, 0x01, 0x01, 0x00}, // 'T'
+  {0x3F, 0x40, 0x40, 0x40, 0x3F, 0x00}, // 'U'
+  {0x1F, 0x20, 0x40, 0x20, 0x1F, 0x00}, // 'V'
+  {0x3F, 0x40, 0x38, 0x40, 0x3F, 0x00}, // 'W'
+  {0x63, 0x14, 0x08, 0x14, 0x63, 0x00}, // 'X'
+  {0x07, 0x08, 0x70, 0x08, 0x07, 0x00}, // 'Y'
+  {0x61, 0x51, 0x49, 0x45, 0x43, 0x00}, // 'Z'
+  {0x00, 0x7F, 0x41, 0x41, 0x00, 0x00}, // '['
+  {0x02, 0x04, 0x08, 0x10, 0x20, 0x00}, // '\'
+  {0x00, 0x41, 0x41, 0x7F, 0x00, 0x00}, // ']'
+  {0x04, 0x02, 0x01, 0x02, 0x04, 0x00}, // '^'
+  {0x40, 0x40, 0x40, 0x40, 0x40, 0x00}, // '_'
+  {0x00, 0x01, 0x02, 0x04, 0x00, 0x00}, // '`'
+  {0x20, 0x54, 0x54, 0x54, 0x78, 0x00}, // 'a'
+  {0x7F, 0x48, 0x44, 0x44, 0x38, 0x00}, // 'b'
+  {0x38, 0x44, 0x44, 0x44, 0x20, 0x00}, // 'c'
+  {0x38, 0x44, 0x44, 0x48, 0x7F, 0x00}, // 'd'
+  {0x38, 0x54, 0x54, 0x54, 0x18, 0x00}, // 'e'
+  {0x08, 0x7E, 0x09, 0x01, 0x02, 0x00}, // 'f'
+  {0x0C, 0x52, 0x52, 0x52, 0x3E, 0x00}, // 'g'
+  {0x7F, 0x08, 0x04, 0x04, 0x78, 0x00}, // 'h'
+  {0x00, 0x44, 0x7D, 0x40, 0x00, 0x00}, // 'i'
+  {0x20, 0x40, 0x44, 0x3D, 0x00, 0x00}, // 'j'
+  {0x7F, 0x10, 0x28, 0x44, 0x00, 0x00}, // 'k'
+  {0x00, 0x41, 0x7F, 0x40, 0x00, 0x00}, // 'l'
+  {0x7C, 0x04, 0x18, 0x04, 0x78, 0x00}, // 'm'
+  {0x7C, 0x08, 0x04, 0x04, 0x78, 0x00}, // 'n'
+  {0x38, 0x44, 0x44, 0x44, 0x38, 0x00}, // 'o'
+  {0x7C, 0x14, 0x14, 0x14, 0x08, 0x00}, // 'p'
+  {0x08, 0x14, 0x14, 0x18, 0x7C, 0x00}, // 'q'
+  {0x7C, 0x08, 0x04, 0x04, 0x08, 0x00}, // 'r'
+  {0x48, 0x54, 0x54, 0x54, 0x20, 0x00}, // 's'
+  {0x04, 0x3F, 0x44, 0x40, 0x20, 0x00}, // 't'
+  {0x3C, 0x40, 0x40, 0x20, 0x7C, 0x00}, // 'u'
+  {0x1C, 0x20, 0x40, 0x20, 0x1C, 0x00}, // 'v'
+  {0x3C, 0x40, 0x30, 0x40, 0x3C, 0x00}, // 'w'
+  {0x44, 0x28, 0x10, 0x28, 0x44, 0x00}, // 'x'
+  {0x0C, 0x50, 0x50, 0x50, 0x3C, 0x00}, // 'y'
+  {0x44, 0x64, 0x54, 0x4C, 0x44, 0x00}, // 'z'
+  {0x00, 0x08, 0x36, 0x41, 0x00, 0x00}, // '{'
+  {0x00, 0x00, 0x7F, 0x00, 0x00, 0x00}, // '|'
+  {0x00, 0x41, 0x36, 0x08, 0x00, 0x00}, // '}'
+  {0x08, 0x04, 0x08, 0x10, 0x08, 0x00}, // '~'
+  {0x00, 0x06, 0x09, 0x09, 0x06, 0x00}, // degree sign
+};
+
+static const uint8_t gau8Blank[SSD1306_WIDTH] = {0};
+
+// ==================== Implementation ================
+
+/**
+ * Copies columns into a page of the framebuffer, marks them dirty if they change.
+ * @param psState Ptr. to SSD1306 state descriptor.
+ * @param u8Page Page index.
+ * @param u8X First column.
+ * @param pu8Src Columns to copy.
+ * @param u8Len Number of columns (must not exceed the right edge).
+ */
+static void _blit(SSsd1306StateDesc *psState, uint8_t u8Page, uint8_t u8X, const uint8_t *pu8Src, uint8_t u8Len) {
+  uint8_t *pu8Dst = &psState->au8Fb[u8Page][u8X];
+  if (0 != memcmp(pu8Dst, pu8Src, u8Len)) {
+    memcpy(pu8Dst, pu8Src, u8Len);
+    ssd1306_mark_dirty(psState, u8Page, u8X, u8X + u8Len);
+  }
+}
+
+// ==================== Interface functions ================
+
+const uint8_t *ssd1306_glyph(char c) {
+  uint8_t u8C = (uint8_t) c;
+  if (u8C < SSD1306TEXT_FIRST || SSD1306TEXT_LAST < u8C) {
+    u8C = '?';
+  }
+  return gau8Font[u8C - SSD1306TEXT_FIRST];
+}
+
+uint8_t ssd1306_draw_char(SSsd1306StateDesc *psState, uint8_t u8X, uint8_t u8Y, char c) {
+  if (SSD1306_WIDTH <= u8X || SSD1306_HEIGHT <= u8Y) {
+    return u8X + SSD1306TEXT_ADVANCE;
+  }
+  const uint8_t *pu8Glyph = ssd1306_glyph(c);
+  uint8_t u8Len = SSD1306_WIDTH - u8X < SSD1306TEXT_ADVANCE ? SSD1306_WIDTH - u8X : SSD1306TEXT_ADVANCE;
+  uint8_t u8Page = u8Y / 8;
+  uint8_t u8Shift = u8Y % 8;
+
+  if (0 == u8Shift) {
+    _blit(psState, u8Page, u8X, pu8Glyph, u8Len);
+  } else {
+    // the glyph cell covers the bottom of u8Page and the top of the next page
+    uint8_t u8MaskLo = 0xFF << u8Shift;
+    uint8_t u8MaskHi = 0xFF >> (8 - u8Shift);
+    for (uint8_t i = 0; i < u8Len; ++i) {
+      uint8_t u8Lo = (psState->au8Fb[u8Page][u8X + i] & ~u8MaskLo) | (pu8Glyph[i] << u8Shift);
+      ssd1306_set_byte(psState, u8Page, u8X + i, u8Lo);
+      if (u8Page + 1 < SSD1306_PAGES) {
+        uint8_t u8Hi = (psState->au8Fb[u8Page + 1][u8X + i] & ~u8MaskHi) | (pu8Glyph[i] >> (8 - u8Shift));
+        ssd1306_set_byte(psState, u8Page + 1, u8X + i, u8Hi);
+      }
+    }
+  }
+  return u8X + SSD1306TEXT_ADVANCE;
+}
+
+uint8_t ssd1306_draw_text(SSsd1306StateDesc *psState, uint8_t u8X, uint8_t u8Y, const char *pcText) {
+  for (; *pcText && u8X < SSD1306_WIDTH; ++pcText) {
+    u8X = ssd1306_draw_char(psState, u8X, u8Y, *pcText);
+  }
+  return u8X;
+}
+
+void ssd1306_draw_line(SSsd1306StateDesc *psState, uint8_t u8Page, const char *pcText) {
+  if (SSD1306_PAGES <= u8Page) return;
+  uint8_t u8X = ssd1306_draw_text(psState, 0, u8Page * 8, pcText);
+  if (u8X < SSD1306_WIDTH) {
+    _blit(psState, u8Page, u8X, gau8Blank, SSD1306_WIDTH - u8X);
+  }
+}
@@ -0,0 +1,70 @@
+/*
+ * Copyright 2025 SZIGETI János
+ *
+ * This file is part of Bilis ESP32 Basic, which is released under GNU General Public License.version 3.
+ * See LICENSE or <https://www.gnu.org/licenses/> for full license details.
+ */
+/** @file ssd1306text.h
+ * Text rendering into the SSD1306 framebuffer with a 5x7 font.
+ * The glyphs are stored pre-transposed in the page layout of the framebuffer: one byte per column,
+ * including the spacing column. If the text is page-aligned (y is a multiple of 8), a glyph blit is
+ * a single SSD1306TEXT_ADVANCE-byte copy; otherwise each column is shifted into two pages.
+ * Only the changed glyph cells are marked dirty.
+ */
+#ifndef SSD1306TEXT_H
+#define SSD1306TEXT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "ssd1306.h"
+
+#define SSD1306TEXT_ADVANCE 6U    ///< Width of a glyph cell (5 columns + spacing).
+#define SSD1306TEXT_HEIGHT 8U     ///< Height of a glyph cell (7 rows + descender / spacing).
+#define SSD1306TEXT_COLS (SSD1306_WIDTH / SSD1306TEXT_ADVANCE) ///< Characters per line.
+#define SSD1306TEXT_FIRST 0x20    ///< First character of the font.
+#define SSD1306TEXT_LAST 0x7F     ///< Last character of the font (0x7F is the degree sign).
+#define SSD1306TEXT_DEGREE "\x7F" ///< Degree sign for string literals.
+
+  /**
+   * Columns of a glyph.
+   * @param c Character (characters outside of the font are replaced with '?').
+   * @return SSD1306TEXT_ADVANCE bytes, bit n of a byte is row n of the glyph.
+   */
+  const uint8_t *ssd1306_glyph(char c);
+
+  /**
+   * Draws a character. The glyph cell is clipped at the right and bottom edges.
+   * @param psState Ptr. to SSD1306 state descriptor.
+   * @param u8X Left column.
+   * @param u8Y Top row.
+   * @param c Character.
+   * @return Left column of the next character.
+   */
+  uint8_t ssd1306_draw_char(SSsd1306StateDesc *psState, uint8_t u8X, uint8_t u8Y, char c);
+
+  /**
+   * Draws a zero-terminated string (no line wrapping).
+   * @param psState Ptr. to SSD1306 state descriptor.
+   * @param u8X Left column.
+   * @param u8Y Top row.
+   * @param pcText Text.
+   * @return Left column of the next character.
+   */
+  uint8_t ssd1306_draw_text(SSsd1306StateDesc *psState, uint8_t u8X, uint8_t u8Y, const char *pcText);
+
+  /**
+   * Draws a string as a full text line: the rest of the page is cleared.
+   * @param psState Ptr. to SSD1306 state descriptor.
+   * @param u8Page Page (text line) index.
+   * @param pcText Text (at most SSD1306TEXT_COLS characters are visible).
+   */
+  void ssd1306_draw_line(SSsd1306StateDesc *psState, uint8_t u8Page, const char *pcText);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SSD1306TEXT_H */
@@ -61,6 +61,14 @@ static void _diotxend_isr(void *pvParam);
 static void _reset_state(STm1637State *psState, SInternals sX);
 static void _next_byte(void *pvParam);
 static void _start_tx_process(STm1637State *psState, SInternals sX);
+static void _chain_diotxend_isr(void *pvParam);
+static void _chain_clktxend_isr(void *pvParam);
+static void _chain_next_byte(STm1637Chain *psChain);
+static void _chain_start_tx_process(STm1637Chain *psChain, SInternals sX);
+static bool _rmt_config_one(ERmtChannel eChannel, uint8_t u8Divisor);
+static SInternals _prepare_full(STm1637State *psState, uint8_t u8Len);
+static SInternals _prepare_range(STm1637State *psState, uint8_t u8Pos, uint8_t u8Len);
+static SInternals _prepare_brightness(STm1637State *psState);
 
 // =================== Global constants ================
 
@@ -102,6 +110,11 @@ static void IRAM_ATTR _clktxend_isr(void *pvParam) {
   STm1637State *psParam = (STm1637State*) pvParam;
 
   if (psParam->sByteI.u8End < psParam->sByteI.u8Cur) {
+    if (psParam->abNak) {
+      // the device may have missed any of the bytes
+      psParam->abShadowValid = 0;
+      psParam->u8ShadowBrightness = TM1637_SHADOW_UNKNOWN;
+    }
     psParam->fReadyCb(psParam->pvReadyCbArg);
   } else {
     bool bDioHi = gpio_pin_read(psParam->sIface.u8DioPin);
@@ -112,6 +125,62 @@ static void IRAM_ATTR _clktxend_isr(void *pvParam) {
   }
 }
 
+/**
+ * Chained version of _diotxend_isr(): registered only on the DIO channel of the last member.
+ * All the DIO sequences have the same length, and the DIO channels are started in member order,
+ * so the DIO channel of the last member is the last one to end: the RAM of every member can be refilled then.
+ * The shared CLK sequence is updated once, the DIO sequences of all members are updated with their own bytes.
+ * @param pvParam TM1637 chain descriptor.
+ */
+static void IRAM_ATTR _chain_diotxend_isr(void *pvParam) {
+  STm1637Chain *psChain = (STm1637Chain*) pvParam;
+  STm1637State *psLead = psChain->asMembers;
+
+  bool bFirst = (psLead->sByteI.u8Cur == psLead->sByteI.u8Begin);
+  bool bDone = (psLead->sByteI.u8Cur == psLead->sByteI.u8End);
+  bool bCmdStart = (psLead->sCmdIdxI.u8Cur < psLead->sCmdIdxI.u8End && psLead->au8CmdIdx[psLead->sCmdIdxI.u8Cur] == psLead->sByteI.u8Cur);
+  bool bCmdStop = !bFirst && (bCmdStart || bDone);
+
+  _update_clkseq(psLead->sIface.eClkCh, bCmdStop, bCmdStart);
+  for (uint8_t i = 0; i < psChain->u8Count; ++i) {
+    STm1637State *psMember = &psChain->asMembers[i];
+    _update_dioseq(psMember->sIface.eDioCh, bCmdStop, bCmdStart, bDone ? 0 : psMember->au8Bytes[psMember->sByteI.u8Cur]);
+    if (bCmdStart) {
+      ++psMember->sCmdIdxI.u8Cur;
+    }
+  }
+}
+
+/**
+ * Chained version of _clktxend_isr(): the ACK bits of all members are read.
+ * @param pvParam TM1637 chain descriptor.
+ */
+static void IRAM_ATTR _chain_clktxend_isr(void *pvParam) {
+  STm1637Chain *psChain = (STm1637Chain*) pvParam;
+  STm1637State *psLead = psChain->asMembers;
+
+  if (psLead->sByteI.u8End < psLead->sByteI.u8Cur) {
+    for (uint8_t i = 0; i < psChain->u8Count; ++i) {
+      STm1637State *psMember = &psChain->asMembers[i];
+      if (psMember->abNak) {
+        psMember->abShadowValid = 0;
+        psMember->u8ShadowBrightness = TM1637_SHADOW_UNKNOWN;
+      }
+    }
+    if (psChain->fReadyCb) {
+      psChain->fReadyCb(psChain->pvReadyCbArg);
+    }
+  } else {
+    for (uint8_t i = 0; i < psChain->u8Count; ++i) {
+      STm1637State *psMember = &psChain->asMembers[i];
+      if (gpio_pin_read(psMember->sIface.u8DioPin)) {
+        psMember->abNak |= (1 << (psMember->sByteI.u8Cur - psMember->sByteI.u8Begin));
+      }
+    }
+    _chain_next_byte(psChain);
+  }
+}
+
 /**
  * Initializes the RMT RAM of the CLK process.
  * Note, this RMT RAM entry sequence is slightly modified before every byte transmission,
@@ -212,6 +281,20 @@ static void _next_byte(void *pvParam) {
 
 }
 
+/**
+ * Chained version of _next_byte(): the shared CLK and all the DIO channels (in member order) are started together.
+ * @param psChain TM1637 chain descriptor.
+ */
+static void _chain_next_byte(STm1637Chain *psChain) {
+  for (uint8_t i = 0; i < psChain->u8Count; ++i) {
+    ++psChain->asMembers[i].sByteI.u8Cur;
+  }
+  rmt_start_tx(psChain->asMembers[0].sIface.eClkCh, true);
+  for (uint8_t i = 0; i < psChain->u8Count; ++i) {
+    rmt_start_tx(psChain->asMembers[i].sIface.eDioCh, true);
+  }
+}
+
 /**
  * Resets Byte and CmdIdx cursors, and sets their bounds.
  * @param psState
@@ -234,8 +317,31 @@ static void _start_tx_process(STm1637State *psState, SInternals sX) {
   _next_byte(psState);
 }
 
-static void _rmt_config_channel(const STm1637Iface *psIface, uint8_t u8Divisor) {
-  // rmt channel config
+/**
+ * Common part of any tm1637_chain_flush_~() functions.
+ * The byte sequences of the members must have been prepared with the same SInternals.
+ * @param psChain TM1637 chain descriptor.
+ * @param sX Communication process length and internal boundaries.
+ */
+static void _chain_start_tx_process(STm1637Chain *psChain, SInternals sX) {
+  for (uint8_t i = 0; i < psChain->u8Count; ++i) {
+    _reset_state(&psChain->asMembers[i], sX);
+  }
+  _chain_diotxend_isr(psChain);
+  _chain_next_byte(psChain);
+}
+
+/**
+ * Configures a single RMT channel and allocates its RAM block.
+ * @param eChannel RMT channel.
+ * @param u8Divisor RMT clock divisor.
+ * @return The RMT RAM block could be allocated.
+ */
+static bool _rmt_config_one(ERmtChannel eChannel, uint8_t u8Divisor) {
+  // the channel config is untouched if the block belongs to another channel
+  if (!rmt_ram_alloc(eChannel, 1, false)) {
+    return false;
+  }
   SRmtChConf rChConf = {
     .r0 =
     {.u8DivCnt = u8Divisor, .u4MemSize = 1,
@@ -245,11 +351,73 @@ static void _rmt_config_channel(const STm1637Iface *psIface, uint8_t u8Divisor)
       .bIdleOutLvl = 1, .bIdleOutEn = 1, .bMemOwner = 0}
   };
 
-  gpsRMT->asChConf[psIface->eClkCh] = rChConf;
-  gpsRMT->asChConf[psIface->eDioCh] = rChConf;
+  gpsRMT->asChConf[eChannel] = rChConf;
+  gpsRMT->arTxLim[eChannel].u9Val = 256; // currently unused
+  return true;
+}
+
+static bool _rmt_config_channel(const STm1637Iface *psIface, uint8_t u8Divisor) {
+  if (!_rmt_config_one(psIface->eClkCh, u8Divisor)) {
+    return false;
+  }
+  if (!_rmt_config_one(psIface->eDioCh, u8Divisor)) {
+    rmt_ram_free(psIface->eClkCh);
+    return false;
+  }
+  return true;
+}
+
+/**
+ * Fills the byte sequence of a full flush (see tm1637_flush_full()).
+ * @param psState TM1637 state descriptor.
+ * @param u8Len Number of cells/characters to update in the display registers.
+ * @return Communication process length and internal boundaries.
+ */
+static SInternals _prepare_full(STm1637State *psState, uint8_t u8Len) {
+  // reset address mode and address
+  psState->au8Bytes[0] = CMD_SETDATA;
+  psState->au8Bytes[1] = CMD_SETADDRESS;
+  for (uint8_t i = 0; i < u8Len; ++i) {
+    psState->au8Bytes[2 + i] = psState->pu8Data[i];
+    psState->au8Shadow[i] = psState->pu8Data[i];
+  }
+  psState->abShadowValid |= (1 << u8Len) - 1;
+  psState->u8ShadowBrightness = psState->u8Brightness & 0x0f;
+  psState->au8Bytes[2 + u8Len] = CMD_CTRLDISPLAY | (psState->u8Brightness & 0x0f);
+  psState->au8CmdIdx[0] = 0;
+  psState->au8CmdIdx[1] = 1;
+  psState->au8CmdIdx[2] = 2 + u8Len;
+  return (SInternals){3 + u8Len, 3};
+}
 
-  gpsRMT->arTxLim[psIface->eClkCh].u9Val = 256; // currently unused
-  gpsRMT->arTxLim[psIface->eDioCh].u9Val = 256; // currently unused
+/**
+ * Fills the byte sequence of a range flush (see tm1637_flush_range()).
+ * @param psState TM1637 state descriptor.
+ * @param u8Pos Start cell/character update at this position.
+ * @param u8Len Number of data bytes to send.
+ * @return Communication process length and internal boundaries.
+ */
+static SInternals _prepare_range(STm1637State *psState, uint8_t u8Pos, uint8_t u8Len) {
+  psState->au8Bytes[0] = CMD_SETADDRESS | (u8Pos & 0x07);
+  for (uint8_t i = 0; i < u8Len; ++i) {
+    psState->au8Bytes[1 + i] = psState->pu8Data[u8Pos + i];
+    psState->au8Shadow[u8Pos + i] = psState->pu8Data[u8Pos + i];
+  }
+  psState->abShadowValid |= ((1 << u8Len) - 1) << u8Pos;
+  psState->au8CmdIdx[0] = 0;
+  return (SInternals){1 + u8Len, 1};
+}
+
+/**
+ * Fills the byte sequence of a brightness flush (see tm1637_flush_brightness()).
+ * @param psState TM1637 state descriptor.
+ * @return Communication process length and internal boundaries.
+ */
+static SInternals _prepare_brightness(STm1637State *psState) {
+  psState->au8Bytes[0] = CMD_CTRLDISPLAY | (psState->u8Brightness & 0x0f);
+  psState->au8CmdIdx[0] = 0;
+  psState->u8ShadowBrightness = psState->u8Brightness & 0x0f;
+  return (SInternals){1, 1};
 }
 
 // ============== Interface functions ==============
@@ -263,6 +431,8 @@ STm1637State tm1637_config(const STm1637Iface *psIface, uint8_t *pu8Data) {
   return (STm1637State){
     .sIface = *psIface,
     .pu8Data = pu8Data,
+    .abShadowValid = 0,
+    .u8ShadowBrightness = TM1637_SHADOW_UNKNOWN,
     .fReadyCb = NULL,
     .pvReadyCbArg = NULL};
 }
@@ -271,21 +441,30 @@ STm1637State tm1637_config(const STm1637Iface *psIface, uint8_t *pu8Data) {
  * Initializes TM1637 communication peripherals.
  * @param psState TM1637 state descriptor.
  * @param u32ApbClkFreq APB clock frequency (used to calculate RMT divisor).
+ * @return The RMT RAM blocks could be allocated (otherwise the channels are not initialized).
  */
-void tm1637_init(STm1637State *psState, uint32_t u32ApbClkFreq) {
+bool tm1637_init(STm1637State *psState, uint32_t u32ApbClkFreq) {
+  if (!_rmt_config_channel(&psState->sIface, u32ApbClkFreq / (1000 * RMT_FREQ_KHZ))) {
+    return false;
+  }
   rmt_init_channel(psState->sIface.eClkCh, psState->sIface.u8ClkPin, true);
   rmt_init_channel(psState->sIface.eDioCh, psState->sIface.u8DioPin, true);
-  _rmt_config_channel(&psState->sIface, u32ApbClkFreq / (1000 * RMT_FREQ_KHZ));
   rmt_isr_register(psState->sIface.eClkCh, RMT_INT_TXEND, _clktxend_isr, psState);
   rmt_isr_register(psState->sIface.eDioCh, RMT_INT_TXEND, _diotxend_isr, psState);
   _init_clkseq(psState->sIface.eClkCh);
+  return true;
 }
 
 /**
- * TODO
- * @param psState
+ * Releases the resources of the TM1637 interface.
+ * Currently only the RMT RAM blocks are released.
+ * @param psState TM1637 state descriptor.
  */
 void tm1637_deinit(STm1637State *psState) {
+  // release RMT RAM blocks
+  rmt_ram_free(psState->sIface.eClkCh);
+  rmt_ram_free(psState->sIface.eDioCh);
+
   // remove interrupts
 
   // release GPIO-RMT bindings
@@ -328,17 +507,7 @@ void tm1637_set_readycb(STm1637State *psState, Isr fHandler, void *pvArg) {
  * @param u8Len Number of cells/characters to update in the display registers.
  */
 void tm1637_flush_full(STm1637State *psState, uint8_t u8Len) {
-  // reset address mode and address
-  psState->au8Bytes[0] = CMD_SETDATA;
-  psState->au8Bytes[1] = CMD_SETADDRESS;
-  for (uint8_t i = 0; i < u8Len; ++i) {
-    psState->au8Bytes[2 + i] = psState->pu8Data[i];
-  }
-  psState->au8Bytes[2 + u8Len] = CMD_CTRLDISPLAY | (psState->u8Brightness & 0x0f);
-  psState->au8CmdIdx[0] = 0;
-  psState->au8CmdIdx[1] = 1;
-  psState->au8CmdIdx[2] = 2 + u8Len;
-  _start_tx_process(psState, (SInternals){3 + u8Len, 3});
+  _start_tx_process(psState, _prepare_full(psState, u8Len));
 }
 
 /**
@@ -349,12 +518,7 @@ void tm1637_flush_full(STm1637State *psState, uint8_t u8Len) {
  * @param u8Len Number of data bytes to send (number of cells/characters to update).
  */
 void tm1637_flush_range(STm1637State *psState, uint8_t u8Pos, uint8_t u8Len) {
-  psState->au8Bytes[0] = CMD_SETADDRESS | (u8Pos & 0x07);
-  for (uint8_t i = 0; i < u8Len; ++i) {
-    psState->au8Bytes[1 + i] = psState->pu8Data[u8Pos + i];
-  }
-  psState->au8CmdIdx[0] = 0;
-  _start_tx_process(psState, (SInternals){1 + u8Len, 1});
+  _start_tx_process(psState, _prepare_range(psState, u8Pos, u8Len));
 }
 
 /**
@@ -364,6 +528,181 @@ void tm1637_flush_range(STm1637State *psState, uint8_t u8Pos, uint8_t u8Len) {
  * @param psState TM1637 state descriptor.
  */
 void tm1637_flush_brightness(STm1637State *psState) {
-  psState->au8Bytes[0] = CMD_CTRLDISPLAY | (psState->u8Brightness & 0x0f);
-  _start_tx_process(psState, (SInternals){1, 1});
+  _start_tx_process(psState, _prepare_brightness(psState));
+}
+
+/**
+ * Sends only what has changed since the last transmission.
+ * The cells are compared with the shadow copy of the last transmitted data, and the minimal
+ * contiguous range covering the changed (or never transmitted) cells is sent with a single CMD_SETADDRESS.
+ * CMD_CTRLDISPLAY is appended only if the brightness has changed.
+ * Until the first successful transmission, a full flush is made (it also sets the write mode).
+ * Failed ACKs invalidate the shadow copy, so the next call retransmits everything.
+ * @param psState TM1637 state descriptor.
+ * @param u8Len Number of cells/characters of the display.
+ * @return A communication process is started (false: nothing has changed, the ready callback is not invoked).
+ */
+bool tm1637_flush_auto(STm1637State *psState, uint8_t u8Len) {
+  uint8_t u8Brightness = psState->u8Brightness & 0x0f;
+  bool bCtrl = (psState->u8ShadowBrightness != u8Brightness);
+  uint8_t u8Begin = u8Len;
+  uint8_t u8End = 0;
+
+  if (psState->u8ShadowBrightness == TM1637_SHADOW_UNKNOWN && 0 == psState->abShadowValid) {
+    tm1637_flush_full(psState, u8Len);
+    return true;
+  }
+  for (uint8_t i = 0; i < u8Len; ++i) {
+    if (!(psState->abShadowValid & (1 << i)) || psState->au8Shadow[i] != psState->pu8Data[i]) {
+      if (u8Begin == u8Len) {
+        u8Begin = i;
+      }
+      u8End = i + 1;
+    }
+  }
+  if (u8End <= u8Begin) {
+    if (!bCtrl) {
+      return false;
+    }
+    tm1637_flush_brightness(psState);
+    return true;
+  }
+
+  uint8_t u8Cnt = u8End - u8Begin;
+  psState->au8Bytes[0] = CMD_SETADDRESS | (u8Begin & 0x07);
+  for (uint8_t i = 0; i < u8Cnt; ++i) {
+    psState->au8Bytes[1 + i] = psState->pu8Data[u8Begin + i];
+    psState->au8Shadow[u8Begin + i] = psState->pu8Data[u8Begin + i];
+  }
+  psState->abShadowValid |= ((1 << u8Cnt) - 1) << u8Begin;
+  psState->au8CmdIdx[0] = 0;
+  if (bCtrl) {
+    psState->au8Bytes[1 + u8Cnt] = CMD_CTRLDISPLAY | u8Brightness;
+    psState->au8CmdIdx[1] = 1 + u8Cnt;
+    psState->u8ShadowBrightness = u8Brightness;
+  }
+  _start_tx_process(psState, (SInternals){1 + u8Cnt + (bCtrl ? 1 : 0), bCtrl ? 2 : 1});
+  return true;
+}
+
+/**
+ * Initializes a chain descriptor.
+ * The members must be configured by tm1637_config() with the same CLK GPIO pin and RMT channel,
+ * and distinct DIO pins and channels. tm1637_init() must not be called for the members.
+ * @param asMembers Array of member state descriptors.
+ * @param u8Count Number of members (1 .. TM1637_CHAIN_MAX).
+ * @return Initialized chain descriptor.
+ */
+STm1637Chain tm1637_chain_config(STm1637State *asMembers, uint8_t u8Count) {
+  return (STm1637Chain){
+    .asMembers = asMembers,
+    .u8Count = (TM1637_CHAIN_MAX < u8Count ? TM1637_CHAIN_MAX : u8Count),
+    .fReadyCb = NULL,
+    .pvReadyCbArg = NULL};
+}
+
+/**
+ * Initializes the communication peripherals of a chain: the shared CLK channel and the DIO channels of the members.
+ * @param psChain TM1637 chain descriptor.
+ * @param u32ApbClkFreq APB clock frequency (used to calculate RMT divisor).
+ * @return The RMT RAM blocks could be allocated (otherwise the channels are not initialized).
+ */
+bool tm1637_chain_init(STm1637Chain *psChain, uint32_t u32ApbClkFreq) {
+  uint8_t u8Divisor = u32ApbClkFreq / (1000 * RMT_FREQ_KHZ);
+  STm1637State *psLead = psChain->asMembers;
+
+  if (0 == psChain->u8Count || !_rmt_config_one(psLead->sIface.eClkCh, u8Divisor)) {
+    return false;
+  }
+  for (uint8_t i = 0; i < psChain->u8Count; ++i) {
+    if (!_rmt_config_one(psChain->asMembers[i].sIface.eDioCh, u8Divisor)) {
+      while (0 < i) {
+        rmt_ram_free(psChain->asMembers[--i].sIface.eDioCh);
+      }
+      rmt_ram_free(psLead->sIface.eClkCh);
+      return false;
+    }
+  }
+  rmt_init_channel(psLead->sIface.eClkCh, psLead->sIface.u8ClkPin, true);
+  for (uint8_t i = 0; i < psChain->u8Count; ++i) {
+    rmt_init_channel(psChain->asMembers[i].sIface.eDioCh, psChain->asMembers[i].sIface.u8DioPin, true);
+  }
+  rmt_isr_register(psLead->sIface.eClkCh, RMT_INT_TXEND, _chain_clktxend_isr, psChain);
+  rmt_isr_register(psChain->asMembers[psChain->u8Count - 1].sIface.eDioCh, RMT_INT_TXEND, _chain_diotxend_isr, psChain);
+  _init_clkseq(psLead->sIface.eClkCh);
+  return true;
+}
+
+/**
+ * Releases the resources of the chain (currently only the RMT RAM blocks).
+ * @param psChain TM1637 chain descriptor.
+ */
+void tm1637_chain_deinit(STm1637Chain *psChain) {
+  rmt_ram_free(psChain->asMembers[0].sIface.eClkCh);
+  for (uint8_t i = 0; i < psChain->u8Count; ++i) {
+    rmt_ram_free(psChain->asMembers[i].sIface.eDioCh);
+  }
+}
+
+/**
+ * Set callback function and parameter of the chain.
+ * This callback function will be invoked when the communication process of all the members is over.
+ * @param psChain TM1637 chain descriptor.
+ * @param fHandler Callback function.
+ * @param pvArg Parameter of the callback function.
+ */
+void tm1637_chain_set_readycb(STm1637Chain *psChain, Isr fHandler, void *pvArg) {
+  psChain->fReadyCb = fHandler;
+  psChain->pvReadyCbArg = pvArg;
+}
+
+/**
+ * Full flush of all the members in parallel (see tm1637_flush_full()).
+ * @param psChain TM1637 chain descriptor.
+ * @param u8Len Number of cells/characters to update in the display registers.
+ */
+void tm1637_chain_flush_full(STm1637Chain *psChain, uint8_t u8Len) {
+  SInternals sX;
+
+  if (0 == psChain->u8Count) {
+    return;
+  }
+  for (uint8_t i = 0; i < psChain->u8Count; ++i) {
+    sX = _prepare_full(&psChain->asMembers[i], u8Len);
+  }
+  _chain_start_tx_process(psChain, sX);
+}
+
+/**
+ * Limited display register update of all the members in parallel (see tm1637_flush_range()).
+ * @param psChain TM1637 chain descriptor.
+ * @param u8Pos Start cell/character update at this position.
+ * @param u8Len Number of data bytes to send.
+ */
+void tm1637_chain_flush_range(STm1637Chain *psChain, uint8_t u8Pos, uint8_t u8Len) {
+  SInternals sX;
+
+  if (0 == psChain->u8Count) {
+    return;
+  }
+  for (uint8_t i = 0; i < psChain->u8Count; ++i) {
+    sX = _prepare_range(&psChain->asMembers[i], u8Pos, u8Len);
+  }
+  _chain_start_tx_process(psChain, sX);
+}
+
+/**
+ * Sets brightness on all the members in parallel (see tm1637_flush_brightness()).
+ * @param psChain TM1637 chain descriptor.
+ */
+void tm1637_chain_flush_brightness(STm1637Chain *psChain) {
+  SInternals sX;
+
+  if (0 == psChain->u8Count) {
+    return;
+  }
+  for (uint8_t i = 0; i < psChain->u8Count; ++i) {
+    sX = _prepare_brightness(&psChain->asMembers[i]);
+  }
+  _chain_start_tx_process(psChain, sX);
 }
@@ -15,6 +15,9 @@ extern "C" {
 #define TM1637_MAXCELLS 6      ///< Number of 7 segment cells.
 #define TM1637_MAXCOMMANDS 3   ///< Max. number of commands in a communication procedure.
 
+#define TM1637_CHAIN_MAX (RMT_CHANNEL_NUM - 1) ///< Max. number of displays sharing a CLK channel.
+#define TM1637_SHADOW_UNKNOWN 0xFF  ///< u8ShadowBrightness value before the first transmission and after failed ACKs.
+
 #include "rmt.h"
 
   typedef struct {
@@ -39,20 +42,45 @@ extern "C" {
     SRange8Idx sCmdIdxI;                   ///< Current anCmdIdx index.
     uint8_t au8CmdIdx[TM1637_MAXCOMMANDS];   ///< au8Bytes indices of commands.
     uint8_t u8Brightness;
+    uint8_t au8Shadow[TM1637_MAXCELLS];   ///< Cell data as last transmitted to the device.
+    uint8_t abShadowValid;                ///< Boolean array of au8Shadow validity. Bit_n is 1: au8Shadow[n] is known.
+    uint8_t u8ShadowBrightness;           ///< Display control as last transmitted (TM1637_SHADOW_UNKNOWN if not known).
     uint32_t abNak;                       ///< Boolean array of ACK outcomes. Bit_n is 1: Failed ACK.
     Isr fReadyCb;                         ///< Callback function to invoke when the whole transfer is complete.
     void *pvReadyCbArg;                   ///< Argument to pass to fReadyCb function.
   } STm1637State;
 
+  /**
+   * Displays sharing a single CLK RMT channel (and GPIO pin), each of them with its own DIO channel.
+   * The byte sequences of the members are transmitted in parallel, so the command structure
+   * (flush type, position and length) is common, only the data and brightness values differ.
+   * N displays need N + 1 RMT channels.
+   */
+  typedef struct {
+    STm1637State *asMembers;              ///< Member displays (their sIface.eClkCh and u8ClkPin are the shared ones).
+    uint8_t u8Count;                      ///< Number of members.
+    Isr fReadyCb;                         ///< Callback function to invoke when the whole transfer is complete.
+    void *pvReadyCbArg;                   ///< Argument to pass to fReadyCb function.
+  } STm1637Chain;
+
 
   STm1637State tm1637_config(const STm1637Iface *psIface, uint8_t *pu8Data);
-  void tm1637_init(STm1637State *psState, uint32_t u32ApbClkFreq);
+  bool tm1637_init(STm1637State *psState, uint32_t u32ApbClkFreq);
   void tm1637_deinit(STm1637State *psState);
   void tm1637_set_brightness(STm1637State *psState, bool bOn, uint8_t u8Value);
   void tm1637_set_readycb(STm1637State *psState, Isr fHandler, void *pvArg);
   void tm1637_flush_full(STm1637State *psState, uint8_t u8Len);
   void tm1637_flush_range(STm1637State *psState, uint8_t u8Pos, uint8_t u8Len);
   void tm1637_flush_brightness(STm1637State *psState);
+  bool tm1637_flush_auto(STm1637State *psState, uint8_t u8Len);
+
+  STm1637Chain tm1637_chain_config(STm1637State *asMembers, uint8_t u8Count);
+  bool tm1637_chain_init(STm1637Chain *psChain, uint32_t u32ApbClkFreq);
+  void tm1637_chain_deinit(STm1637Chain *psChain);
+  void tm1637_chain_set_readycb(STm1637Chain *psChain, Isr fHandler, void *pvArg);
+  void tm1637_chain_flush_full(STm1637Chain *psChain, uint8_t u8Len);
+  void tm1637_chain_flush_range(STm1637Chain *psChain, uint8_t u8Pos, uint8_t u8Len);
+  void tm1637_chain_flush_brightness(STm1637Chain *psChain);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,154 @@
+/*
+ * Copyright 2025 SZIGETI János
+ *
+ * This file is part of Bilis ESP32 Basic, which is released under GNU General Public License.version 3.
+ * See LICENSE or <https://www.gnu.org/licenses/> for full license details.
+ */
+#include <stdbool.h>
+#include <string.h>
+#include "esp_attr.h"
+#include "tm1637anim.h"
+
+#define DISPLAY_ON_BIT 0x08 ///< Display on bit of the brightness value (see tm1637_set_brightness()).
+
+// ================ Local function declarations =================
+static void _ready_isr(void *pvParam);
+static void _frame_isr(void *pvParam);
+static void _scroll_step(STm1637Anim *psAnim);
+static void _next_frame(STm1637Anim *psAnim);
+static void _bind(STm1637Anim *psAnim, void *pvText, const SToByteFunctions *psTextFunc, ETm1637AnimMode eMode);
+
+// =================== Global constants ================
+
+/**
+ * 7 segment codes of the characters 0x20 .. 0x7F.
+ */
+static const uint8_t gau8Segments[] = {
+  0x00, 0x86, 0x22, 0x00, 0x6D, 0x00, 0x00, 0x02, 0x39, 0x0F, 0x63, 0x00, 0x80, 0x40, 0x80, 0x52, //  !"#$%&'()*+,-./
+  0x3F, 0x06, 0x5B, 0x4F, 0x66, 0x6D, 0x7D, 0x07, 0x7F, 0x6F, 0x00, 0x00, 0x00, 0x48, 0x00, 0x53, // 0123456789:;<=>?
+  0x00, 0x77, 0x7C, 0x39, 0x5E, 0x79, 0x71, 0x3D, 0x76, 0x30, 0x1E, 0x75, 0x38, 0x15, 0x37, 0x3F, // @ABCDEFGHIJKLMNO
+  0x73, 0x6B, 0x33, 0x6D, 0x78, 0x3E, 0x3E, 0x2A, 0x76, 0x6E, 0x5B, 0x39, 0x64, 0x0F, 0x23, 0x08, // PQRSTUVWXYZ[\]^_
+  0x20, 0x5F, 0x7C, 0x58, 0x5E, 0x7B, 0x71, 0x6F, 0x74, 0x10, 0x0C, 0x75, 0x30, 0x14, 0x54, 0x5C, // `abcdefghijklmno
+  0x73, 0x67, 0x50, 0x6D, 0x78, 0x1C, 0x1C, 0x14, 0x76, 0x6E, 0x5B, 0x39, 0x30, 0x0F, 0x01, 0x63  // pqrstuvwxyz{|}~°
+};
+
+// ==================== Implementation ================
+
+/**
+ * TM1637 ready callback: the frame is on the display, the next one is scheduled.
+ * @param pvParam Animation state descriptor.
+ */
+static void IRAM_ATTR _ready_isr(void *pvParam) {
+  STm1637Anim *psAnim = (STm1637Anim*) pvParam;
+  ++psAnim->u32Frames;
+  if (psAnim->bStopping) {
+    psAnim->eMode = TM1637ANIM_IDLE;
+  } else if (TM1637ANIM_IDLE != psAnim->eMode) {
+    timg_callback_dt(psAnim->sTimer, psAnim->u32tckFrame, psAnim->u8Int, _frame_isr, psAnim);
+  }
+}
+
+/**
+ * Timer alarm: time of the next frame.
+ * @param pvParam Animation state descriptor.
+ */
+static void IRAM_ATTR _frame_isr(void *pvParam) {
+  STm1637Anim *psAnim = (STm1637Anim*) pvParam;
+  gapsTIMG[psAnim->sTimer.eTimg]->INT_CLR_TIMERS |= 1 << psAnim->sTimer.eTimer;
+  _next_frame(psAnim);
+}
+
+/**
+ * Shifts the frame to the left by a cell, the next character (or a blank) enters from the right.
+ * After the text has left the display, the animation either restarts or stops.
+ * @param psAnim Animation state descriptor.
+ */
+static void IRAM_ATTR _scroll_step(STm1637Anim *psAnim) {
+  uint8_t u8Seg = 0;
+  for (uint8_t i = 1; i < psAnim->u8Cells; ++i) {
+    psAnim->au8Frame[i - 1] = psAnim->au8Frame[i];
+  }
+  if (!psAnim->psTextFunc->fEnd(psAnim->pvText)) {
+    u8Seg = tm1637anim_segments(psAnim->psTextFunc->fNext(psAnim->pvText));
+  } else if (psAnim->u8Cells <= ++psAnim->u8Tail) {
+    // this frame is blank
+    if (psAnim->bLoop) {
+      psAnim->psTextFunc->fReset(psAnim->pvText);
+      psAnim->u8Tail = 0;
+    } else {
+      psAnim->bStopping = true;
+    }
+  }
+  psAnim->au8Frame[psAnim->u8Cells - 1] = u8Seg;
+}
+
+/**
+ * Computes and sends the next frame. If the display does not change, the frame after it is scheduled directly.
+ * @param psAnim Animation state descriptor.
+ */
+static void IRAM_ATTR _next_frame(STm1637Anim *psAnim) {
+  if (psAnim->bStopping) {
+    // last frame: only the pending display control change (if any) is sent
+    psAnim->psDisplay->u8Brightness |= DISPLAY_ON_BIT;
+  } else if (TM1637ANIM_SCROLL == psAnim->eMode) {
+    _scroll_step(psAnim);
+  } else {
+    psAnim->psDisplay->u8Brightness ^= DISPLAY_ON_BIT;
+  }
+  if (!tm1637_flush_auto(psAnim->psDisplay, psAnim->u8Cells)) {
+    _ready_isr(psAnim);
+  }
+}
+
+/**
+ * Takes over the display and sets the text source.
+ */
+static void _bind(STm1637Anim *psAnim, void *pvText, const SToByteFunctions *psTextFunc, ETm1637AnimMode eMode) {
+  psAnim->pvText = pvText;
+  psAnim->psTextFunc = psTextFunc;
+  psAnim->eMode = eMode;
+  psAnim->bStopping = false;
+  psAnim->psDisplay->pu8Data = psAnim->au8Frame;
+  psAnim->psDisplay->u8Brightness |= DISPLAY_ON_BIT;
+  tm1637_set_readycb(psAnim->psDisplay, _ready_isr, psAnim);
+}
+
+// ============== Interface functions ==============
+
+uint8_t tm1637anim_segments(char c) {
+  uint8_t u8C = (uint8_t) c;
+  return (u8C < 0x20 || 0x7F < u8C) ? 0x00 : gau8Segments[u8C - 0x20];
+}
+
+STm1637Anim tm1637anim_init(STm1637State *psDisplay, uint8_t u8Cells, TimerId sTimer, uint8_t u8Int, uint32_t u32tckFrame) {
+  STm1637Anim sRet;
+  memset(&sRet, 0, sizeof (sRet));
+  sRet.psDisplay = psDisplay;
+  sRet.u8Cells = (TM1637_MAXCELLS < u8Cells ? TM1637_MAXCELLS : u8Cells);
+  sRet.sTimer = sTimer;
+  sRet.u8Int = u8Int;
+  sRet.u32tckFrame = u32tckFrame;
+  sRet.eMode = TM1637ANIM_IDLE;
+  return sRet;
+}
+
+void tm1637anim_start_scroll(STm1637Anim *psAnim, void *pvText, const SToByteFunctions *psTextFunc, bool bLoop) {
+  memset(psAnim->au8Frame, 0, sizeof (psAnim->au8Frame));
+  psAnim->u8Tail = 0;
+  psAnim->bLoop = bLoop;
+  _bind(psAnim, pvText, psTextFunc, TM1637ANIM_SCROLL);
+  _next_frame(psAnim);
+}
+
+void tm1637anim_start_blink(STm1637Anim *psAnim, void *pvText, const SToByteFunctions *psTextFunc) {
+  for (uint8_t i = 0; i < psAnim->u8Cells; ++i) {
+    psAnim->au8Frame[i] = psTextFunc->fEnd(pvText) ? 0x00 : tm1637anim_segments(psTextFunc->fNext(pvText));
+  }
+  _bind(psAnim, pvText, psTextFunc, TM1637ANIM_BLINK);
+  psAnim->psDisplay->u8Brightness &= ~DISPLAY_ON_BIT; // the first frame turns it on
+  _next_frame(psAnim);
+}
+
+void tm1637anim_stop(STm1637Anim *psAnim) {
+  psAnim->bStopping = true;
+}
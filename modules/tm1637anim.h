@@ -0,0 +1,113 @@
+/*
+ * Copyright 2025 SZIGETI János
+ *
+ * This file is part of Bilis ESP32 Basic, which is released under GNU General Public License.version 3.
+ * See LICENSE or <https://www.gnu.org/licenses/> for full license details.
+ */
+/** @file tm1637anim.h
+ * Text animations (scrolling, blinking) on a TM1637 display, running entirely in ISR context.
+ * The characters of the text are taken from a byte generator (e.g. SByteGenState) and mapped to
+ * 7 segment codes by a lookup table. When a frame is on the display (TM1637 ready callback),
+ * the next frame is scheduled with a timer alarm; the alarm ISR computes the frame and flushes it
+ * with tm1637_flush_auto(), so only the changed cells (or only the display control byte) are sent.
+ */
+#ifndef TM1637ANIM_H
+#define TM1637ANIM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "timg.h"
+#include "tm1637.h"
+#include "utils/generators.h"
+
+#define TM1637ANIM_DEGREE "\x7F" ///< Degree sign for string literals.
+
+  typedef enum {
+    TM1637ANIM_IDLE = 0, ///< No animation is running.
+    TM1637ANIM_SCROLL,   ///< The text scrolls from right to left.
+    TM1637ANIM_BLINK     ///< The beginning of the text is displayed, the display is turned on and off.
+  } ETm1637AnimMode;
+
+  /**
+   * State descriptor of the animation engine.
+   */
+  typedef struct {
+    STm1637State *psDisplay;    ///< Display to animate (its data source is au8Frame).
+    void *pvText;               ///< State of the text generator.
+    const SToByteFunctions *psTextFunc; ///< Functions of the text generator (fNext, fEnd, fReset are used).
+    uint8_t au8Frame[TM1637_MAXCELLS]; ///< Current frame (7 segment codes).
+    uint8_t u8Cells;            ///< Number of cells of the display.
+    uint8_t u8Tail;             ///< Number of blank cells scrolled in after the end of the text.
+    ETm1637AnimMode eMode;
+    bool bLoop;                 ///< Scrolling restarts after the text has left the display.
+    bool bStopping;             ///< The animation stops when the current frame is on the display.
+    TimerId sTimer;             ///< Timer of the frame scheduling.
+    uint8_t u8Int;              ///< Interrupt channel of the timer alarm.
+    uint32_t u32tckFrame;       ///< Frame period (in timer ticks).
+    uint32_t u32Frames;         ///< Number of displayed frames.
+  } STm1637Anim;
+
+  /**
+   * 7 segment code of a character.
+   * @param c Character (0x7F is the degree sign; characters without a sensible representation are blank).
+   * @return 7 segment code (bit 0: segment A, ... bit 6: segment G, bit 7: dot / colon).
+   */
+  uint8_t tm1637anim_segments(char c);
+
+  /**
+   * Initializes the animation engine.
+   * @param psDisplay Initialized TM1637 display (tm1637_init() is already called).
+   * @param u8Cells Number of cells of the display.
+   * @param sTimer Timer of the frame scheduling (its alarm is used, it must be running).
+   * @param u8Int Interrupt channel for the timer alarm.
+   * @param u32tckFrame Frame period (in timer ticks).
+   * @return Initialized state descriptor.
+   */
+  STm1637Anim tm1637anim_init(STm1637State *psDisplay, uint8_t u8Cells, TimerId sTimer, uint8_t u8Int, uint32_t u32tckFrame);
+
+  /**
+   * Starts scrolling a text: the display starts blank, the text enters from the right
+   * and scrolls out to the left.
+   * The ready callback and the data source of the display are taken over (psAnim must not be moved afterwards).
+   * Must be called when no transfer of the display is in progress (e.g. the previous animation has stopped).
+   * @param psAnim Animation state descriptor.
+   * @param pvText State of the text generator (must be valid while the animation runs).
+   * @param psTextFunc Functions of the text generator (e.g. &gsByteGenFunc).
+   * @param bLoop Restart the text (after resetting the generator) when it has left the display.
+   */
+  void tm1637anim_start_scroll(STm1637Anim *psAnim, void *pvText, const SToByteFunctions *psTextFunc, bool bLoop);
+
+  /**
+   * Starts blinking a text: the first cells of the text are displayed, and the display is turned on and off.
+   * Only the display control byte is sent in each frame.
+   * The same restrictions apply as for tm1637anim_start_scroll().
+   * @param psAnim Animation state descriptor.
+   * @param pvText State of the text generator (read only once).
+   * @param psTextFunc Functions of the text generator.
+   */
+  void tm1637anim_start_blink(STm1637Anim *psAnim, void *pvText, const SToByteFunctions *psTextFunc);
+
+  /**
+   * Requests stopping the animation: the next frame is the last one (scrolling keeps the current frame,
+   * blinking stops in the on state). tm1637anim_is_running() returns false when it is on the display.
+   * @param psAnim Animation state descriptor.
+   */
+  void tm1637anim_stop(STm1637Anim *psAnim);
+
+  /**
+   * @param psAnim Animation state descriptor.
+   * @return An animation is running (or its last frame is being transmitted).
+   */
+  static inline bool tm1637anim_is_running(const STm1637Anim *psAnim) {
+    return TM1637ANIM_IDLE != psAnim->eMode;
+  }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TM1637ANIM_H */
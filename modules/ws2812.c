@@ -21,7 +21,7 @@
 #define RMT_CLK_NS            (1000000 / RMT_FREQ_KHZ)
 
 // ================ Local function declarations =================
-static void _rmt_config_channel(const SWs2812Iface *psIface, uint8_t u8Divisor);
+static bool _rmt_config_channel(const SWs2812Iface *psIface, uint8_t u8Divisor);
 void _byte_to_rmtram(RegAddr prDest, uint8_t u8Value);
 static bool _put_next_byte(SWs2812State *psState);
 static void _feeder(void *pvParam);
@@ -55,24 +55,23 @@ const uint32_t *pu32EntryPair = (const uint32_t*)gau16Entries;
 
 // ==================== Implementation ================
 
-static void _rmt_config_channel(const SWs2812Iface *psIface, uint8_t u8Divisor) {
+static bool _rmt_config_channel(const SWs2812Iface *psIface, uint8_t u8Divisor) {
+  // memory size and ownership of RMT RAM blocks (the channel config is untouched on failure)
+  if (!rmt_ram_alloc(psIface->eChannel, psIface->u8Blocks, false)) {
+    return false;
+  }
+
   // rmt channel config
   SRmtChConf rChConf = {
     .r0 =
     {.u8DivCnt = u8Divisor, .u4MemSize = psIface->u8Blocks, .bCarrierEn = false, .bCarrierOutLvl = 1},
     .r1 =
-    {.bRefAlwaysOn = 1, .bRefCntRst = 1, .bMemRdRst = 1, .bIdleOutLvl = 0, .bIdleOutEn = 0}
+    {.bRefAlwaysOn = 1, .bRefCntRst = 1, .bMemRdRst = 1, .bIdleOutLvl = 0, .bIdleOutEn = 0, .bMemOwner = 0}
   };
   gpsRMT->asChConf[psIface->eChannel] = rChConf;
 
-  // set memory ownership of RMT RAM blocks
-  SRmtChConf1Reg sRdMemCfg = {.raw = -1};
-  sRdMemCfg.bMemOwner = 0;
-  for (int i = 0; i < psIface->u8Blocks; ++i) {
-    gpsRMT->asChConf[(psIface->eChannel + i) % RMT_CHANNEL_NUM].r1.raw &= sRdMemCfg.raw;
-  }
-
   gpsRMT->arTxLim[psIface->eChannel].u9Val = (psIface->u8Blocks * RMT_RAM_BLOCK_SIZE) / 2;
+  return true;
 }
 
 /**
@@ -122,11 +121,18 @@ static void _feeder(void *pvParam) {
 
 // ============== Interface functions ==============
 
-void ws2812_init(uint8_t u8Pin, uint32_t u32ApbClkFreq, SWs2812State *psFeederState, Isr fTxEndCb, void *pvTxEndCbParam) {
+bool ws2812_init(uint8_t u8Pin, uint32_t u32ApbClkFreq, SWs2812State *psFeederState, Isr fTxEndCb, void *pvTxEndCbParam) {
+  if (!_rmt_config_channel(&psFeederState->sIface, u32ApbClkFreq / (1000 * RMT_FREQ_KHZ))) {
+    return false;
+  }
   rmt_init_channel(psFeederState->sIface.eChannel, u8Pin, false);
-  _rmt_config_channel(&psFeederState->sIface, u32ApbClkFreq / (1000 * RMT_FREQ_KHZ));
   rmt_isr_register(psFeederState->sIface.eChannel, RMT_INT_TXTHRES, _feeder, psFeederState);
   rmt_isr_register(psFeederState->sIface.eChannel, RMT_INT_TXEND, fTxEndCb, pvTxEndCbParam);
+  return true;
+}
+
+void ws2812_deinit(SWs2812State *psFeederState) {
+  rmt_ram_free(psFeederState->sIface.eChannel);
 }
 
 void ws2812_start(SWs2812State *psFeederState) {
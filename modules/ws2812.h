@@ -56,7 +56,17 @@ extern "C" {
   }
   // ============= Interface function declaration ===============
 
-  void ws2812_init(uint8_t u8Pin, uint32_t u32ApbClkFreq, SWs2812State *psFeederState, Isr fTxEndCb, void *pvTxEndCbParam);
+  /**
+   * Initializes the RMT channel and allocates its RMT RAM blocks.
+   * @param u8Pin GPIO pin.
+   * @param u32ApbClkFreq APB clock frequency.
+   * @param psFeederState State descriptor.
+   * @param fTxEndCb Callback invoked when the transmission is done.
+   * @param pvTxEndCbParam Parameter of fTxEndCb.
+   * @return The RMT RAM blocks could be allocated (otherwise the channel is not initialized).
+   */
+  bool ws2812_init(uint8_t u8Pin, uint32_t u32ApbClkFreq, SWs2812State *psFeederState, Isr fTxEndCb, void *pvTxEndCbParam);
+  void ws2812_deinit(SWs2812State *psFeederState);
   void ws2812_start(SWs2812State *psFeederState);
 
 #ifdef __cplusplus
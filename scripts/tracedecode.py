@@ -0,0 +1,121 @@
+#!/usr/bin/env python3
+
+## Decodes the binary trace frames of utils/trace.h.
+## Plain text (e.g. uart_printf output) is passed through, trace frames are
+## formatted with the format strings found in the .trace_fmt section of the ELF file.
+## Input:
+##  $1 ELF file of the program
+##  [$2] input: serial port, file or - for stdin (default: -)
+##  [$3] speed of the serial port (default: 115200)
+
+import re
+import stat
+import struct
+import sys
+import os
+
+SYNC = 0xA5
+MAXARGS = 4
+CONVERSION = re.compile(r'%([-+ #0]*)(\d*)(?:\.(\d+))?(?:hh|h|ll|l|z|j|t)?([diouxXc%])')
+
+
+def read_section(elf_path, name):
+    with open(elf_path, 'rb') as f:
+        data = f.read()
+    if data[:4] != b'\x7fELF':
+        sys.exit('%s: not an ELF file' % elf_path)
+    is64 = data[4] == 2
+    end = '<' if data[5] == 1 else '>'
+    if is64:
+        shoff, = struct.unpack_from(end + 'Q', data, 0x28)
+        shentsize, shnum, shstrndx = struct.unpack_from(end + 'HHH', data, 0x3A)
+        shdr = end + 'IIQQQQIIQQ'
+    else:
+        shoff, = struct.unpack_from(end + 'I', data, 0x20)
+        shentsize, shnum, shstrndx = struct.unpack_from(end + 'HHH', data, 0x2E)
+        shdr = end + 'IIIIIIIIII'
+    sections = [struct.unpack_from(shdr, data, shoff + i * shentsize) for i in range(shnum)]
+    names_off = sections[shstrndx][4]
+    for sec in sections:
+        sec_name = data[names_off + sec[0]:data.index(b'\0', names_off + sec[0])].decode()
+        if sec_name == name:
+            return data[sec[4]:sec[4] + sec[5]]
+    sys.exit('%s: no %s section' % (elf_path, name))
+
+
+def format_message(fmt, args):
+    args = list(args)
+
+    def convert(match):
+        flags, width, precision, conv = match.groups()
+        if conv == '%':
+            return '%'
+        value = args.pop(0) if args else 0
+        if conv in 'di':
+            value = value - (1 << 32) if value & 0x80000000 else value
+            conv = 'd'
+        elif conv == 'u':
+            conv = 'd'
+        elif conv == 'c':
+            value = chr(value & 0xFF)
+        spec = '%' + flags + width + ('.' + precision if precision else '') + conv
+        return spec % value
+
+    return CONVERSION.sub(convert, fmt)
+
+
+def decode(strings, stream, out):
+    buf = bytearray()
+    while True:
+        chunk = stream.read(1)
+        if not chunk:
+            break
+        buf += chunk
+        while buf:
+            if buf[0] != SYNC:
+                out.write(chr(buf.pop(0)))
+                continue
+            if len(buf) < 2:
+                break
+            argc = buf[1]
+            if MAXARGS < argc:
+                buf.pop(0)
+                continue
+            length = 5 + 4 * argc
+            if len(buf) < length:
+                break
+            if sum(buf[1:length - 1]) & 0xFF != buf[length - 1]:
+                buf.pop(0)  # not a frame: resynchronize
+                continue
+            fmt_id, = struct.unpack_from('<H', buf, 2)
+            args = struct.unpack_from('<%dI' % argc, buf, 4)
+            del buf[:length]
+            end = strings.find(b'\0', fmt_id)
+            if fmt_id < len(strings) and 0 <= end:
+                out.write(format_message(strings[fmt_id:end].decode(errors='replace'), args))
+            else:
+                out.write('<unknown trace format %d %s>\n' % (fmt_id, args))
+        out.flush()
+
+
+def main():
+    if len(sys.argv) < 2:
+        sys.exit('usage: %s ELF [PORT|FILE|-] [SPEED]' % sys.argv[0])
+    strings = read_section(sys.argv[1], '.trace_fmt')
+    source = sys.argv[2] if 2 < len(sys.argv) else '-'
+    speed = int(sys.argv[3]) if 3 < len(sys.argv) else 115200
+    if source == '-':
+        stream = sys.stdin.buffer
+    elif stat.S_ISCHR(os.stat(source).st_mode):
+        import serial
+        stream = serial.Serial(source, speed)
+    else:
+        stream = open(source, 'rb')
+    try:
+        decode(strings, stream, sys.stdout)
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == '__main__':
+    main()
@@ -7,6 +7,7 @@
 #ifndef PRINT_H
 #define PRINT_H
 
+#include <stdint.h>
 #include <string.h>
 
 
@@ -16,6 +17,11 @@ extern "C" {
 
 #define ZERO_CHR '0'
 #define HEXA_LO_CHR 'a'
+#define DEC_CHUNK 1000000000U ///< 10^9: the largest power of 10 that fits into uint32_t.
+#define DEC_CHUNK_DIGITS 9U
+
+  /// "00", "01", ... "99": two decimal digits are emitted in one step (defined in print.c).
+  extern const char gacDecDigitPairs[200];
 
   static inline char *str_append(char *dst, const char *src) {
     return strcpy(dst, src) + strlen(src);
@@ -49,6 +55,103 @@ extern "C" {
     return dst_e;
   }
 
+  /**
+   * Number of decimal digits.
+   * @param u32Value Value.
+   * @return 1 .. 10 (0 has 1 digit).
+   */
+  static inline uint8_t dec_len32(uint32_t u32Value) {
+    // compare ladder: at most 4 comparisons, no multiplications
+    if (u32Value < 100000U) {
+      return (u32Value < 100U) ? ((u32Value < 10U) ? 1 : 2) :
+              (u32Value < 1000U) ? 3 :
+              (u32Value < 10000U) ? 4 : 5;
+    }
+    return (u32Value < 10000000U) ? ((u32Value < 1000000U) ? 6 : 7) :
+            (u32Value < 100000000U) ? 8 :
+            (u32Value < 1000000000U) ? 9 : 10;
+  }
+
+  /**
+   * Writes the lowest u8Len digits of a value right-to-left (zero filled), two digits per step.
+   * @param dst_e End of the digits (they are written before this position).
+   * @param u32Value Value.
+   * @param u8Len Number of digits.
+   */
+  static inline void print_dec_digits(char *dst_e, uint32_t u32Value, uint8_t u8Len) {
+    for (; 2 <= u8Len; u8Len -= 2) {
+      uint32_t u32Pair = u32Value % 100U;
+      u32Value /= 100U;
+      dst_e -= 2;
+      dst_e[0] = gacDecDigitPairs[2 * u32Pair];
+      dst_e[1] = gacDecDigitPairs[2 * u32Pair + 1];
+    }
+    if (u8Len) {
+      *(dst_e - 1) = ZERO_CHR + u32Value % 10U;
+    }
+  }
+
+  /**
+   * Fast variant of print_dec(): the digits are written into their final position (no reversal).
+   * Unlike print_dec(), 0 is printed as "0".
+   * @param dst Destination (at least 11 bytes).
+   * @param u32Value Value.
+   * @return End of the printed number (the terminating zero is written here).
+   */
+  static inline char *print_dec32(char *dst, uint32_t u32Value) {
+    uint8_t u8Len = dec_len32(u32Value);
+    print_dec_digits(dst + u8Len, u32Value, u8Len);
+    dst[u8Len] = 0;
+    return dst + u8Len;
+  }
+
+  /**
+   * Prints a 64 bit value: it is split into chunks of 9 digits (at most two 64 bit divisions),
+   * the chunks are printed with 32 bit operations.
+   * @param dst Destination (at least 21 bytes).
+   * @param u64Value Value.
+   * @return End of the printed number (the terminating zero is written here).
+   */
+  static inline char *print_dec64(char *dst, uint64_t u64Value) {
+    if (u64Value <= UINT32_MAX) {
+      return print_dec32(dst, (uint32_t) u64Value);
+    }
+    uint64_t u64Hi = u64Value / DEC_CHUNK;
+    uint32_t u32Lo = (uint32_t) (u64Value - u64Hi * DEC_CHUNK);
+    if (u64Hi <= UINT32_MAX) {
+      dst = print_dec32(dst, (uint32_t) u64Hi);
+    } else {
+      uint32_t u32Top = (uint32_t) (u64Hi / DEC_CHUNK);
+      dst = print_dec32(dst, u32Top);
+      dst += DEC_CHUNK_DIGITS;
+      print_dec_digits(dst, (uint32_t) (u64Hi - (uint64_t) u32Top * DEC_CHUNK), DEC_CHUNK_DIGITS);
+    }
+    dst += DEC_CHUNK_DIGITS;
+    print_dec_digits(dst, u32Lo, DEC_CHUNK_DIGITS);
+    *dst = 0;
+    return dst;
+  }
+
+  /**
+   * Fast variant of print_dec_padded(): the value is right-aligned in a field of u8Width characters.
+   * Unlike print_dec_padded(), 0 is printed as "0" (the padding character does not replace it).
+   * If the value has more digits than u8Width, only the lowest u8Width digits are printed.
+   * @param dst Destination.
+   * @param u32Value Value.
+   * @param u8Width Width of the field.
+   * @param cPad Padding character.
+   * @return End of the field (no terminating zero).
+   */
+  static inline char *print_dec32_padded(char *dst, uint32_t u32Value, uint8_t u8Width, char cPad) {
+    uint8_t u8Len = dec_len32(u32Value);
+    if (u8Width < u8Len) {
+      u8Len = u8Width;
+    }
+    memset(dst, cPad, u8Width - u8Len);
+    print_dec_digits(dst + u8Width, u32Value, u8Len);
+    return dst + u8Width;
+  }
+
   static inline char *print_deccent(char *dst, uint32_t u32Num, char cSep) {
     char *dst_e = print_dec(dst, u32Num / 100);
     if (dst_e == dst) {
@@ -97,6 +200,8 @@ extern "C" {
 
 #undef ZERO_CHR
 #undef HEXA_LO_CHR
+#undef DEC_CHUNK
+#undef DEC_CHUNK_DIGITS
 
 #ifdef __cplusplus
 }
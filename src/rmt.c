@@ -22,6 +22,8 @@ typedef struct {
 
 // ==================== Local data ================
 SRmtIntDispatcher gsIntDispatcher;
+/// Owner of each RMT RAM block: 0 if the block is free, channel index + 1 otherwise.
+static uint8_t gau8RamBlockOwner[RMT_CHANNEL_NUM];
 
 // ============== Internal function declarations ==============
 void _dispatch_isr(void *pvParam);
@@ -95,6 +97,8 @@ void rmt_isr_register(ERmtChannel eChannel, ERmtIntType eIntType, Isr fIsr, void
 /**
  * Global RMT peripherial initialization.
  * Enables peripheral in DPORT and sets basic ApbConf attributes.
+ * The peripheral is reset, thus the RMT RAM block ownership table of rmt_ram_alloc() is cleared as well:
+ * call it once, before any channel allocates its blocks.
  * @param bMemAccessEn attribute to set in rApb.
  * @param bMemTxWrapEn attribute to set in rApb.
  */
@@ -107,6 +111,67 @@ void rmt_init_controller(bool bMemAccessEn, bool bMemTxWrapEn) {
   SRmtApbConfReg rApbConf = {.bMemAccessEn = bMemAccessEn, .bMemTxWrapEn = bMemTxWrapEn};
   gpsRMT->rApb = rApbConf;
 
+  memset(gau8RamBlockOwner, 0, sizeof (gau8RamBlockOwner));
+}
+
+/**
+ * Assigns RMT RAM blocks to a channel.
+ * A channel always uses its own block and the subsequent ones, hence the allocation
+ * succeeds only if none of the blocks [eChannel, eChannel + u8Blocks) is owned by another channel.
+ * On success the memory size and the memory owner bits of the blocks are set.
+ * If the channel already has blocks assigned, those are reassigned.
+ * @param eChannel Identifies the RMT channel.
+ * @param u8Blocks Number of RMT RAM blocks (1..8).
+ * @param bRxOwner Memory ownership: RX (true) or TX (false).
+ * @return The blocks are assigned to the channel.
+ */
+bool rmt_ram_alloc(ERmtChannel eChannel, uint8_t u8Blocks, bool bRxOwner) {
+  if (u8Blocks == 0 || RMT_CHANNEL_NUM < u8Blocks) {
+    return false;
+  }
+  for (uint8_t i = 0; i < u8Blocks; ++i) {
+    uint8_t u8Owner = gau8RamBlockOwner[(eChannel + i) % RMT_CHANNEL_NUM];
+    if (u8Owner != 0 && u8Owner != eChannel + 1) {
+      return false;
+    }
+  }
+  rmt_ram_free(eChannel);
+  for (uint8_t i = 0; i < u8Blocks; ++i) {
+    uint8_t u8Block = (eChannel + i) % RMT_CHANNEL_NUM;
+    gau8RamBlockOwner[u8Block] = eChannel + 1;
+    gpsRMT->asChConf[u8Block].r1.bMemOwner = bRxOwner;
+  }
+  gpsRMT->asChConf[eChannel].r0.u4MemSize = u8Blocks;
+  return true;
+}
+
+/**
+ * Releases the RMT RAM blocks assigned to a channel.
+ * The memory owner bits of the released blocks are reset to transmitter (software access).
+ * @param eChannel Identifies the RMT channel.
+ */
+void rmt_ram_free(ERmtChannel eChannel) {
+  for (uint8_t i = 0; i < RMT_CHANNEL_NUM; ++i) {
+    if (gau8RamBlockOwner[i] == eChannel + 1) {
+      gau8RamBlockOwner[i] = 0;
+      gpsRMT->asChConf[i].r1.bMemOwner = false;
+    }
+  }
+}
+
+/**
+ * Tells the number of RMT RAM blocks assigned to a channel.
+ * @param eChannel Identifies the RMT channel.
+ * @return Number of assigned blocks (0, if the channel has no blocks assigned).
+ */
+uint8_t rmt_ram_blocks(ERmtChannel eChannel) {
+  uint8_t u8Ret = 0;
+  for (uint8_t i = 0; i < RMT_CHANNEL_NUM; ++i) {
+    if (gau8RamBlockOwner[i] == eChannel + 1) {
+      ++u8Ret;
+    }
+  }
+  return u8Ret;
 }
 
 /**
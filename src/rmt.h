@@ -187,6 +187,17 @@ extern "C" {
     return gpsRMTRAM + u32IdxInRam;
   }
 
+  /**
+   * Tells the current RX write position of an RMT channel relative to the first register of the channel.
+   * (The RX index in the status register is an absolute RMT RAM index.)
+   * @param eChannel Identifies the RMT channel.
+   * @return Relative index of the next register the receiver will write.
+   */
+  static inline uint16_t rmt_rx_pos(ERmtChannel eChannel) {
+    uint32_t u32AbsIdx = gpsRMT->asStatus[eChannel].u9RxIdx;
+    return (u32AbsIdx + (RMT_CHANNEL_NUM - eChannel) * RMT_RAM_BLOCK_SIZE) % (RMT_CHANNEL_NUM * RMT_RAM_BLOCK_SIZE);
+  }
+
   /**
    * Tells the bit position of an interrupt in RMT interrupt registers (RAW / ST / ENA / CLR).
    * @param eChannel Identifies the RMT channel.
@@ -256,6 +267,9 @@ extern "C" {
   void rmt_isr_init();
   void rmt_isr_start(ECpu eCpu, uint8_t u8IntChannel);
   void rmt_isr_register(ERmtChannel eChannel, ERmtIntType eIntType, Isr fIsr, void *pvParam);
+  bool rmt_ram_alloc(ERmtChannel eChannel, uint8_t u8Blocks, bool bRxOwner);
+  void rmt_ram_free(ERmtChannel eChannel);
+  uint8_t rmt_ram_blocks(ERmtChannel eChannel);
 
 #ifdef __cplusplus
 }
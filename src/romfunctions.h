@@ -14,6 +14,7 @@ extern "C" {
 #include <stdbool.h>
 #include <stdint.h>
 
+  void ets_isr_mask(uint32_t mask);
   void ets_isr_unmask(uint32_t mask);
   void _xtos_set_interrupt_handler(int irq_number, void* function);
   void _xtos_set_interrupt_handler_arg(int irq_number, void* function, int argument);
@@ -0,0 +1,87 @@
+/*
+ * Copyright 2025 SZIGETI János
+ *
+ * This file is part of Bilis ESP32 Basic, which is released under GNU General Public License.version 3.
+ * See LICENSE or <https://www.gnu.org/licenses/> for full license details.
+ */
+#include <stdbool.h>
+
+#include "dport.h"
+#include "gpio.h"
+#include "iomux.h"
+#include "romfunctions.h"
+#include "uart.h"
+
+#define UART0_TXD_IDX 14U
+#define UART0_RXD_IDX 14U
+#define UART1_TXD_IDX 17U
+#define UART1_RXD_IDX 17U
+#define UART2_TXD_IDX 198U
+#define UART2_RXD_IDX 198U
+#define DPORT_UART0_BIT 2U
+#define DPORT_UART1_BIT 5U
+#define DPORT_UART2_BIT 23U
+
+// CONF0 fields
+#define UART_CONF0_PARITY_SHIFT 0U
+#define UART_CONF0_PARITY_MASK (3U << UART_CONF0_PARITY_SHIFT)      ///< parity (odd) and parity_en bits
+#define UART_CONF0_BIT_NUM_SHIFT 2U
+#define UART_CONF0_BIT_NUM_MASK (3U << UART_CONF0_BIT_NUM_SHIFT)
+#define UART_CONF0_STOP_BIT_NUM_SHIFT 4U
+#define UART_CONF0_STOP_BIT_NUM_MASK (3U << UART_CONF0_STOP_BIT_NUM_SHIFT)
+// RS485_CONF fields
+#define UART_RS485_DL1_EN (1U << 2)  ///< Delay of 1 bit after the stop bit.
+
+static inline uint8_t _txd_idx(EUart eUart) {
+  return eUart == UART0 ? UART0_TXD_IDX : (eUart == UART1 ? UART1_TXD_IDX : UART2_TXD_IDX);
+}
+
+static inline uint8_t _rxd_idx(EUart eUart) {
+  return eUart == UART0 ? UART0_RXD_IDX : (eUart == UART1 ? UART1_RXD_IDX : UART2_RXD_IDX);
+}
+
+/**
+ * Get DPORT_PERIP_{CLK|RST}_EN_REG bit of the given UART.
+ * @param eUart UART controller
+ * @return Bit
+ */
+static inline uint8_t _dport_peri_bit(EUart eUart) {
+  return eUart == UART0 ? DPORT_UART0_BIT : (eUart == UART1 ? DPORT_UART1_BIT : DPORT_UART2_BIT);
+}
+
+void uart_init_controller(EUart eUart, uint8_t u8TxPin, uint8_t u8RxPin) {
+  IomuxGpioConfReg rTxConf = {.u3McuSel = 2};
+  IomuxGpioConfReg rRxConf = {.u1FunIE = 1, .u1FunWPU = 1, .u3McuSel = 2};
+
+  dport_regs()->PERIP_CLK_EN |= 1 << _dport_peri_bit(eUart);
+  dport_regs()->PERIP_RST_EN |= 1 << _dport_peri_bit(eUart);
+  dport_regs()->PERIP_RST_EN &= ~(1 << _dport_peri_bit(eUart));
+
+  gpio_pin_out_on(u8TxPin); // idle level
+  iomux_set_gpioconf(u8TxPin, rTxConf);
+  iomux_set_gpioconf(u8RxPin, rRxConf);
+  gpio_pin_enable(u8TxPin);
+  gpio_matrix_out(u8TxPin, _txd_idx(eUart), 0, 0);
+  gpio_matrix_in(u8RxPin, _rxd_idx(eUart), 0);
+}
+
+void uart_set_baudrate(UART_Type *psUART, uint32_t u32ApbFreqHz, uint32_t u32Baud) {
+  // divisor in 1/16 units (16 * 80 MHz still fits into 32 bits)
+  uint32_t u32Div16 = (16 * u32ApbFreqHz + u32Baud / 2) / u32Baud;
+  psUART->CLKDIV.raw = (u32Div16 >> 4) | ((u32Div16 & 0xF) << 20);
+}
+
+uint32_t uart_get_baudrate(const UART_Type *psUART, uint32_t u32ApbFreqHz) {
+  uint32_t u32Div16 = (psUART->CLKDIV.u20ClkDiv << 4) | psUART->CLKDIV.u4ClkDivFrag;
+  return u32Div16 ? (16 * u32ApbFreqHz + u32Div16 / 2) / u32Div16 : 0;
+}
+
+void uart_set_format(UART_Type *psUART, EUartDataBits eDataBits, EUartParity eParity, EUartStopBits eStopBits) {
+  // ESP32 hw bug: 2 stop bits are generated as 1 stop bit + 1 bit delay
+  bool bTwoStopBits = (eStopBits == UART_STOP_2);
+  register_set_bits(&psUART->CONF0,
+          (eParity << UART_CONF0_PARITY_SHIFT) | (eDataBits << UART_CONF0_BIT_NUM_SHIFT)
+          | ((bTwoStopBits ? UART_STOP_1 : eStopBits) << UART_CONF0_STOP_BIT_NUM_SHIFT),
+          UART_CONF0_PARITY_MASK | UART_CONF0_BIT_NUM_MASK | UART_CONF0_STOP_BIT_NUM_MASK);
+  register_set_bits(&psUART->RS485_CONF, bTwoStopBits ? UART_RS485_DL1_EN : 0, UART_RS485_DL1_EN);
+}
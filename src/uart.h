@@ -57,6 +57,31 @@ extern "C" {
     Reg NEGPULSE;
   } UART_Type;
 
+  typedef enum {
+    UART0 = 0,
+    UART1 = 1,
+    UART2 = 2
+  } EUart;
+
+  typedef enum {
+    UART_DATA_5BITS = 0,
+    UART_DATA_6BITS = 1,
+    UART_DATA_7BITS = 2,
+    UART_DATA_8BITS = 3
+  } EUartDataBits;
+
+  typedef enum {
+    UART_PARITY_NONE = 0,
+    UART_PARITY_EVEN = 2,
+    UART_PARITY_ODD = 3
+  } EUartParity;
+
+  typedef enum {
+    UART_STOP_1 = 1,
+    UART_STOP_1_5 = 2,
+    UART_STOP_2 = 3
+  } EUartStopBits;
+
   extern UART_Type gsUART0;
   extern UART_Type gsUART1;
   extern UART_Type gsUART2;
@@ -65,6 +90,44 @@ extern "C" {
   extern UART_Type gsUART1Mapped;
   extern UART_Type gsUART2Mapped;
 
+  static inline UART_Type *uart_regs(EUart eUart) {
+    return eUart == UART0 ? &gsUART0 : (eUart == UART1 ? &gsUART1 : &gsUART2);
+  }
+
+  /**
+   * Enables the clock of a UART controller, resets it, and routes its TX / RX signals
+   * to the given pins through the GPIO matrix (UART1 and UART2 have no usable default pins).
+   * @param eUart UART controller.
+   * @param u8TxPin TX GPIO.
+   * @param u8RxPin RX GPIO.
+   */
+  void uart_init_controller(EUart eUart, uint8_t u8TxPin, uint8_t u8RxPin);
+
+  /**
+   * Sets the baud rate: the divisor (APB clock / baud rate) is set with its 4 bit fractional part,
+   * thus the error stays low at high baud rates (e.g. 921600 or 2000000 baud).
+   * @param psUART UART peripheral.
+   * @param u32ApbFreqHz APB clock frequency.
+   * @param u32Baud Baud rate.
+   */
+  void uart_set_baudrate(UART_Type *psUART, uint32_t u32ApbFreqHz, uint32_t u32Baud);
+
+  /**
+   * @param psUART UART peripheral.
+   * @param u32ApbFreqHz APB clock frequency.
+   * @return Actual baud rate.
+   */
+  uint32_t uart_get_baudrate(const UART_Type *psUART, uint32_t u32ApbFreqHz);
+
+  /**
+   * Sets the frame format.
+   * @param psUART UART peripheral.
+   * @param eDataBits Number of data bits.
+   * @param eParity Parity.
+   * @param eStopBits Number of stop bits.
+   */
+  void uart_set_format(UART_Type *psUART, EUartDataBits eDataBits, EUartParity eParity, EUartStopBits eStopBits);
+
 #ifdef __cplusplus
 }
 #endif
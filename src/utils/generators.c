@@ -4,37 +4,101 @@
  * This file is part of Bilis ESP32 Basic, which is released under GNU General Public License.version 3.
  * See LICENSE or <https://www.gnu.org/licenses/> for full license details.
  */
+#include <string.h>
 #include "generators.h"
 
 #define BIT_END 8
 #define PWMPHASE_END 2
+#define FILL_CHUNK 16U  ///< Size of the intermediate buffer used by composite fill functions.
 
 // ============= Global constants ===============
 const SToByteFunctions gsByteGenFunc = {
   .fNext = (FToByteNext) bytegen_next,
   .fEnd = (FToXEnd) bytegen_end,
-  .fReset = (FToXReset) bytegen_reset
+  .fReset = (FToXReset) bytegen_reset,
+  .fFill = (FToByteFill) bytegen_fill
 };
 
 const SToByteFunctions gsBitGenFunc = {
   .fNext = (FToByteNext) bitgen_next,
   .fEnd = (FToXEnd) bitgen_end,
-  .fResetV = (FByteToXResetV) bitgen_resetv
+  .fResetV = (FByteToXResetV) bitgen_resetv,
+  .fFill = (FToByteFill) bitgen_fill
 };
 
 const SToByteFunctions gsBitSeqGenFunc = {
   .fNext = (FToByteNext) trbytegen_next,
   .fEnd = (FToXEnd) trbytegen_end,
-  .fReset = (FToXReset) trbytegen_reset
+  .fReset = (FToXReset) trbytegen_reset,
+  .fFill = (FToByteFill) trbytegen_fill
 };
 
 const SToWordFunctions gsPwmGenFunc = {
   .fNext = (FToWordNext) pwmgen_next,
   .fEnd = (FToXEnd) pwmgen_end,
-  .fReset = (FToXReset) pwmgen_reset
+  .fReset = (FToXReset) pwmgen_reset,
+  .fFill = (FToWordFill) pwmgen_fill
 };
 
+// ============= Internal function declarations ===============
+static inline uint32_t _pwm_hi(const SPwmXGenState *psState, uint8_t u8Value);
+static inline uint32_t _pwm_lo(const SPwmXGenState *psState, uint8_t u8Value);
+static inline uint32_t _pwm_pair(const SPwmXGenState *psState, uint8_t u8Value);
+static uint32_t _bytes_fill(const SToByteFunctions *psFunc, void *pvState, uint8_t *pu8Dst, uint32_t u32Len);
+
 // ============= Implementation ===============
+// ------------- Internal functions ---------------
+
+/**
+ * High phase entry of a PWM period.
+ * @param psState PWM attributes (period length, upper parts).
+ * @param u8Value Length of the high phase.
+ * @return RMT entry.
+ */
+static inline uint32_t _pwm_hi(const SPwmXGenState *psState, uint8_t u8Value) {
+  return (psState->u8HiUpper << BIT_END) | u8Value;
+}
+
+/**
+ * Low phase entry of a PWM period.
+ * @param psState PWM attributes (period length, upper parts).
+ * @param u8Value Length of the high phase.
+ * @return RMT entry.
+ */
+static inline uint32_t _pwm_lo(const SPwmXGenState *psState, uint8_t u8Value) {
+  return (psState->u8LoUpper << BIT_END) | (uint8_t) (psState->u8PeriodLen - u8Value);
+}
+
+/**
+ * Composes a whole PWM period (high and low phase) into an entry pair.
+ * @param psState PWM attributes (period length, upper parts).
+ * @param u8Value Length of the high phase.
+ * @return Entry pair: high phase in bits 0..15, low phase in bits 16..31.
+ */
+static inline uint32_t _pwm_pair(const SPwmXGenState *psState, uint8_t u8Value) {
+  return _pwm_hi(psState, u8Value) | (_pwm_lo(psState, u8Value) << 16);
+}
+
+/**
+ * Takes at most u32Len bytes from a byte generator: via its fill function,
+ * or one-by-one, if the generator has no fill function (fFill is NULL).
+ * @param psFunc Functions of the byte generator.
+ * @param pvState State descriptor of the byte generator.
+ * @param pu8Dst Destination.
+ * @param u32Len Capacity of the destination.
+ * @return Number of written bytes.
+ */
+static uint32_t _bytes_fill(const SToByteFunctions *psFunc, void *pvState, uint8_t *pu8Dst, uint32_t u32Len) {
+  if (psFunc->fFill) {
+    return psFunc->fFill(pvState, pu8Dst, u32Len);
+  }
+  uint32_t i = 0;
+  for (; i < u32Len && !psFunc->fEnd(pvState); ++i) {
+    pu8Dst[i] = psFunc->fNext(pvState);
+  }
+  return i;
+}
+
 // ------------- Interface functions ---------------
 
 // Byte Generator section
@@ -64,6 +128,14 @@ bool bytegen_end(const SByteGenState *psState) {
   return psState->pu8Cur == psState->pu8End;
 }
 
+uint32_t bytegen_fill(SByteGenState *psState, uint8_t *pu8Dst, uint32_t u32Len) {
+  uint32_t u32Avail = psState->pu8End - psState->pu8Cur;
+  uint32_t u32Ret = u32Len < u32Avail ? u32Len : u32Avail;
+  memcpy(pu8Dst, psState->pu8Cur, u32Ret);
+  psState->pu8Cur += u32Ret;
+  return u32Ret;
+}
+
 
 // Bit Generator section
 
@@ -91,6 +163,14 @@ void bitgen_resetv(SBitGenState *psState, uint8_t u8Value) {
   psState->u8BitIdx = 0;
 }
 
+uint32_t bitgen_fill(SBitGenState *psState, uint8_t *pu8Dst, uint32_t u32Len) {
+  uint32_t i = 0;
+  for (; i < u32Len && psState->u8BitIdx < BIT_END; ++i) {
+    pu8Dst[i] = bitgen_next(psState);
+  }
+  return i;
+}
+
 // Transformed Byte Generator section
 
 uint8_t trbytegen_next(STrByteGenState *psState) {
@@ -110,6 +190,22 @@ void trbytegen_reset(STrByteGenState *psState) {
   while (!psState->psFuncB->fEnd(psState->pvBState)) psState->psFuncB->fNext(psState->pvBState);
 }
 
+/**
+ * Generator (B) fills as many bytes as it can at once,
+ * (A) is invoked only when (B) reaches its end.
+ */
+uint32_t trbytegen_fill(STrByteGenState *psState, uint8_t *pu8Dst, uint32_t u32Len) {
+  uint32_t u32Ret = 0;
+  while (u32Ret < u32Len) {
+    if (psState->psFuncB->fEnd(psState->pvBState)) {
+      if (psState->psFuncA->fEnd(psState->pvAState)) break;
+      psState->psFuncB->fResetV(psState->pvBState, psState->psFuncA->fNext(psState->pvAState));
+    }
+    u32Ret += _bytes_fill(psState->psFuncB, psState->pvBState, pu8Dst + u32Ret, u32Len - u32Ret);
+  }
+  return u32Ret;
+}
+
 // Bit Sequence Generator section
 
 STrByteGenState bitseqgen_init(SByteGenState *psAState, SBitGenState *psBState) {
@@ -158,6 +254,40 @@ void pwmgen_reset(SPwmGenState *psState) {
   psState->u8PhaseIdx = PWMPHASE_END;
 }
 
+/**
+ * The values of (A) are taken in chunks via its fill function.
+ * At a period boundary every entry pair is a whole PWM period. Otherwise (odd number of entries
+ * taken before) the pairs are shifted by one entry: the low phase of the previous value and the
+ * high phase of the next one; the last pair is completed with a 0 entry at the end of (A).
+ */
+uint32_t pwmgen_fill(SPwmGenState *psState, uint32_t *pu32Dst, uint32_t u32Len) {
+  const SPwmXGenState sX = {
+    .u8PeriodLen = psState->u8PeriodLen,
+    .u8HiUpper = psState->u8HiUpper,
+    .u8LoUpper = psState->u8LoUpper
+  };
+  bool bShifted = psState->u8PhaseIdx != PWMPHASE_END;
+  uint8_t au8Buf[FILL_CHUNK];
+  uint32_t u32Ret = 0;
+  while (u32Ret < u32Len) {
+    uint32_t u32Req = (u32Len - u32Ret) < FILL_CHUNK ? (u32Len - u32Ret) : FILL_CHUNK;
+    uint32_t u32Got = _bytes_fill(psState->psFuncA, psState->pvAState, au8Buf, u32Req);
+    for (uint32_t i = 0; i < u32Got; ++i) {
+      pu32Dst[u32Ret++] = bShifted ?
+              (_pwm_lo(&sX, psState->u8CurValue) | (_pwm_hi(&sX, au8Buf[i]) << 16)) : _pwm_pair(&sX, au8Buf[i]);
+      psState->u8CurValue = au8Buf[i];
+    }
+    if (u32Got < u32Req) {
+      if (bShifted) {
+        pu32Dst[u32Ret++] = _pwm_lo(&sX, psState->u8CurValue);
+        psState->u8PhaseIdx = PWMPHASE_END;
+      }
+      break;
+    }
+  }
+  return u32Ret;
+}
+
 // (Faster) PWM Generator section
 
 uint16_t bitpwmgen_next(SBitPwmGenState *psState) {
@@ -179,6 +309,32 @@ bool bitpwmgen_end(const SBitPwmGenState *psState) {
   return bytegen_end(&psState->sByteGenState) && bitgen_end(&psState->sBitGenState) && psState->sPwmXGenState.u8PhaseIdx == PWMPHASE_END;
 }
 
+/**
+ * Same as pwmgen_fill(), but the bits are taken directly from the embedded generators.
+ */
+uint32_t bitpwmgen_fill(SBitPwmGenState *psState, uint32_t *pu32Dst, uint32_t u32Len) {
+  SPwmXGenState *px = &psState->sPwmXGenState;
+  SBitGenState *psBit = &psState->sBitGenState;
+  bool bShifted = px->u8PhaseIdx != PWMPHASE_END;
+  uint32_t u32Ret = 0;
+  while (u32Ret < u32Len) {
+    if (bitgen_end(psBit)) {
+      if (bytegen_end(&psState->sByteGenState)) {
+        if (bShifted) {
+          pu32Dst[u32Ret++] = _pwm_lo(px, px->u8CurValue);
+          px->u8PhaseIdx = PWMPHASE_END;
+        }
+        break;
+      }
+      bitgen_resetv(psBit, bytegen_next(&psState->sByteGenState));
+    }
+    uint8_t u8Value = bitgen_next(psBit);
+    pu32Dst[u32Ret++] = bShifted ? (_pwm_lo(px, px->u8CurValue) | (_pwm_hi(px, u8Value) << 16)) : _pwm_pair(px, u8Value);
+    px->u8CurValue = u8Value;
+  }
+  return u32Ret;
+}
+
 void bitpwmgen_reset(SBitPwmGenState *psState) {
   bytegen_reset(&psState->sByteGenState);
   bitgen_resetv(&psState->sBitGenState, 0);
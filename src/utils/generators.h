@@ -48,6 +48,18 @@ extern "C" {
   typedef void (*FToXReset)(void *pvState);
   typedef void (*FByteToXResetV)(void *pvState, uint8_t u8Value);
   typedef void (*FWordToXResetV)(void *pvState, uint16_t u16Value);
+  /**
+   * Batch variant of FToByteNext: writes at most u32Len bytes into pu8Dst.
+   * Returns the number of written bytes (less than u32Len only if the end of sequence is reached).
+   */
+  typedef uint32_t(*FToByteFill)(void *pvState, uint8_t *pu8Dst, uint32_t u32Len);
+  /**
+   * Batch variant of FToWordNext: writes at most u32Len entry pairs into pu32Dst.
+   * Bits 0..15 of a pair contain the first, bits 16..31 the second generated value.
+   * If the sequence ends after the first value of a pair, the second value is 0.
+   * Returns the number of written pairs (less than u32Len only if the end of sequence is reached).
+   */
+  typedef uint32_t(*FToWordFill)(void *pvState, uint32_t *pu32Dst, uint32_t u32Len);
 
   typedef struct {
     FToByteNext fNext;
@@ -57,6 +69,7 @@ extern "C" {
       FToXReset fReset;
       FByteToXResetV fResetV;
     };
+    FToByteFill fFill; ///< Optional (NULL: the composite generators fall back to fNext / fEnd).
   } SToByteFunctions;
 
   typedef struct {
@@ -67,6 +80,7 @@ extern "C" {
       FToXReset fReset;
       FWordToXResetV fResetV;
     };
+    FToWordFill fFill; ///< Optional (NULL: the caller has to fall back to fNext / fEnd).
   } SToWordFunctions;
 
   /**
@@ -135,15 +149,18 @@ extern "C" {
   uint8_t bytegen_next(SByteGenState *psState);
   bool bytegen_end(const SByteGenState *psState);
   void bytegen_reset(SByteGenState *psState);
+  uint32_t bytegen_fill(SByteGenState *psState, uint8_t *pu8Dst, uint32_t u32Len);
 
   SBitGenState bitgen_init(uint8_t u8Value, bool bUp, uint8_t u8OutHi, uint8_t u8OutLo);
   uint8_t bitgen_next(SBitGenState *psState);
   bool bitgen_end(const SBitGenState *psState);
   void bitgen_resetv(SBitGenState *psState, uint8_t u8Value);
+  uint32_t bitgen_fill(SBitGenState *psState, uint8_t *pu8Dst, uint32_t u32Len);
 
   uint8_t trbytegen_next(STrByteGenState *psState);
   bool trbytegen_end(const STrByteGenState *psState);
   void trbytegen_reset(STrByteGenState *psState);
+  uint32_t trbytegen_fill(STrByteGenState *psState, uint8_t *pu8Dst, uint32_t u32Len);
 
   STrByteGenState bitseqgen_init(SByteGenState *psAState, SBitGenState *psBState);
 
@@ -151,10 +168,12 @@ extern "C" {
   uint16_t pwmgen_next(SPwmGenState *psState);
   bool pwmgen_end(const SPwmGenState *psState);
   void pwmgen_reset(SPwmGenState *psState);
+  uint32_t pwmgen_fill(SPwmGenState *psState, uint32_t *pu32Dst, uint32_t u32Len);
 
   uint16_t bitpwmgen_next(SBitPwmGenState *psState);
   bool bitpwmgen_end(const SBitPwmGenState *psState);
   void bitpwmgen_reset(SBitPwmGenState *psState);
+  uint32_t bitpwmgen_fill(SBitPwmGenState *psState, uint32_t *pu32Dst, uint32_t u32Len);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,298 @@
+/*
+ * Copyright 2025 SZIGETI János
+ *
+ * This file is part of Bilis ESP32 Basic, which is released under GNU General Public License.version 3.
+ * See LICENSE or <https://www.gnu.org/licenses/> for full license details.
+ */
+/** @file genpipe.h
+ * Generator pipelines instantiated at compile time.
+ * The composite generators of generators.h (trbytegen, pwmgen) connect their layers
+ * via function pointers, whereas the hand-written bitpwmgen is faster, since every layer is inlined.
+ * The macros of this file instantiate such fused generators for any chain of
+ * byte -> bit -> PWM -> stretch stages.
+ *
+ * Every stage is identified by a name (N). A stage macro defines
+ *  - the state type GENPIPE_STATE(N) (struct genpipe_N), which contains the state of the
+ *    input stage (sIn) and the state of the stage itself (sStage),
+ *  - static inline N_init(), N_next(), N_end() and N_reset() functions,
+ *  - N_get() (forced inline): N_next() with the end test fused into it (returns false at the end
+ *    of sequence, without changing the state). A stage calls the N_get() of its input only when
+ *    it needs a new input value, so the end of sequence is tested once per output value,
+ *    and the input chain is visited only once per input value.
+ * Each stage (except the source) takes its input stage by name, e.g.:
+ *
+ *   GENPIPE_BYTE_SOURCE(wssrc)
+ *   GENPIPE_BIT_STAGE(wsbit, wssrc)
+ *   GENPIPE_PWM_STAGE(wspwm, wsbit)
+ *   GENPIPE_WORD_FILL(wspwm)
+ *
+ *   GENPIPE_STATE(wspwm) sState;
+ *   wssrc_init(&sState.sIn.sIn, au8Data, szLen);
+ *   wsbit_init(&sState.sIn, false, u8OutHi, u8OutLo);
+ *   wspwm_init(&sState, u8PeriodLen, 0x80, 0x00);
+ *
+ * Any generator providing N_next(), N_end(), N_get() and N_reset() over struct genpipe_N
+ * can act as input of a stage, thus custom sources can be plugged in.
+ */
+#ifndef GENPIPE_H
+#define GENPIPE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "esp_attr.h"
+#include "rmt.h"
+#include "utils/generators.h"
+
+#define GENPIPE_BIT_END 8U        ///< Bit index of an exhausted bit stage.
+#define GENPIPE_PWMPHASE_END 2U   ///< Phase index of a PWM stage at period boundary.
+
+  // ============= Types ===============
+
+  /**
+   * Own state of a stretch stage (see SStretchGenState in rmtutils.h).
+   */
+  typedef struct {
+    uint32_t u32Multiplier; ///< M value of the M/N Period length multiplier.
+    uint32_t u32Divisor;    ///< N value of the M/N Period length multiplier.
+    uint32_t u32OutQueue;   ///< Remaining period length.
+    bool bLevel;            ///< Current output entry signal level.
+  } SStretchXGenState;
+
+  // ============= Inline functions ===============
+
+  static inline SPwmXGenState genpipe_pwmx_init(uint8_t u8PeriodLen, uint8_t u8HiUpper, uint8_t u8LoUpper) {
+    return (SPwmXGenState){
+      .u8CurValue = 0,
+      .u8PeriodLen = u8PeriodLen,
+      .u8HiUpper = u8HiUpper,
+      .u8LoUpper = u8LoUpper,
+      .u8PhaseIdx = GENPIPE_PWMPHASE_END};
+  }
+
+  static inline SStretchXGenState genpipe_stretchx_init(uint32_t u32Multiplier, uint32_t u32Divisor) {
+    return (SStretchXGenState){
+      .u32Multiplier = u32Multiplier,
+      .u32Divisor = u32Divisor,
+      .u32OutQueue = 0,
+      .bLevel = false};
+  }
+
+  // ============= Stage templates ===============
+
+  /// State type of stage N.
+#define GENPIPE_STATE(N) struct genpipe_##N
+
+  /**
+   * Byte source stage: iterates over a byte array (see bytegen).
+   * Output: uint8_t.
+   */
+#define GENPIPE_BYTE_SOURCE(N) \
+  GENPIPE_STATE(N) { \
+    SByteGenState sStage; \
+  }; \
+  static inline void N##_init(GENPIPE_STATE(N) *psState, const uint8_t *pu8Seq, size_t szSeqLen) { \
+    psState->sStage = bytegen_init(pu8Seq, szSeqLen); \
+  } \
+  static inline uint8_t N##_next(GENPIPE_STATE(N) *psState) { \
+    return *(psState->sStage.pu8Cur++); \
+  } \
+  static inline bool N##_end(const GENPIPE_STATE(N) *psState) { \
+    return psState->sStage.pu8Cur == psState->sStage.pu8End; \
+  } \
+  FORCE_INLINE_ATTR bool N##_get(GENPIPE_STATE(N) *psState, uint8_t *pu8Out) { \
+    if (psState->sStage.pu8Cur == psState->sStage.pu8End) return false; \
+    *pu8Out = *(psState->sStage.pu8Cur++); \
+    return true; \
+  } \
+  static inline void N##_reset(GENPIPE_STATE(N) *psState) { \
+    psState->sStage.pu8Cur = psState->sStage.pu8Begin; \
+  }
+
+  /**
+   * Bit stage: iterates over the bits of the bytes generated by stage IN (see bitgen).
+   * Output: uint8_t (u8OutHi or u8OutLo).
+   */
+#define GENPIPE_BIT_STAGE(N, IN) \
+  GENPIPE_STATE(N) { \
+    GENPIPE_STATE(IN) sIn; \
+    SBitGenState sStage; \
+  }; \
+  static inline void N##_init(GENPIPE_STATE(N) *psState, bool bUp, uint8_t u8OutHi, uint8_t u8OutLo) { \
+    psState->sStage = bitgen_init(0, bUp, u8OutHi, u8OutLo); \
+    psState->sStage.u8BitIdx = GENPIPE_BIT_END; \
+  } \
+  static inline uint8_t N##_next(GENPIPE_STATE(N) *psState) { \
+    SBitGenState *px = &psState->sStage; \
+    if (px->u8BitIdx == GENPIPE_BIT_END) { \
+      px->u8Value = IN##_next(&psState->sIn); \
+      px->u8BitIdx = 0; \
+    } \
+    uint8_t u8Mask = 1 << (px->bUp ? px->u8BitIdx : (GENPIPE_BIT_END - 1 - px->u8BitIdx)); \
+    ++px->u8BitIdx; \
+    return (px->u8Value & u8Mask) ? px->u8OutHi : px->u8OutLo; \
+  } \
+  static inline bool N##_end(const GENPIPE_STATE(N) *psState) { \
+    return psState->sStage.u8BitIdx == GENPIPE_BIT_END && IN##_end(&psState->sIn); \
+  } \
+  FORCE_INLINE_ATTR bool N##_get(GENPIPE_STATE(N) *psState, uint8_t *pu8Out) { \
+    SBitGenState *px = &psState->sStage; \
+    if (px->u8BitIdx == GENPIPE_BIT_END) { \
+      if (!IN##_get(&psState->sIn, &px->u8Value)) return false; \
+      px->u8BitIdx = 0; \
+    } \
+    uint8_t u8Mask = 1 << (px->bUp ? px->u8BitIdx : (GENPIPE_BIT_END - 1 - px->u8BitIdx)); \
+    ++px->u8BitIdx; \
+    *pu8Out = (px->u8Value & u8Mask) ? px->u8OutHi : px->u8OutLo; \
+    return true; \
+  } \
+  static inline void N##_reset(GENPIPE_STATE(N) *psState) { \
+    IN##_reset(&psState->sIn); \
+    psState->sStage.u8BitIdx = GENPIPE_BIT_END; \
+  }
+
+  /**
+   * PWM stage: for each byte generated by stage IN, a high and a low entry is generated (see pwmgen).
+   * Output: uint16_t.
+   */
+#define GENPIPE_PWM_STAGE(N, IN) \
+  GENPIPE_STATE(N) { \
+    GENPIPE_STATE(IN) sIn; \
+    SPwmXGenState sStage; \
+  }; \
+  static inline void N##_init(GENPIPE_STATE(N) *psState, uint8_t u8PeriodLen, uint8_t u8HiUpper, uint8_t u8LoUpper) { \
+    psState->sStage = genpipe_pwmx_init(u8PeriodLen, u8HiUpper, u8LoUpper); \
+  } \
+  static inline uint16_t N##_next(GENPIPE_STATE(N) *psState) { \
+    SPwmXGenState *px = &psState->sStage; \
+    if (px->u8PhaseIdx == GENPIPE_PWMPHASE_END) { \
+      px->u8CurValue = IN##_next(&psState->sIn); \
+      px->u8PhaseIdx = 0; \
+    } \
+    uint8_t u8RetUpper = (px->u8PhaseIdx == 0) ? px->u8HiUpper : px->u8LoUpper; \
+    uint8_t u8RetLower = (px->u8PhaseIdx == 0) ? px->u8CurValue : px->u8PeriodLen - px->u8CurValue; \
+    ++px->u8PhaseIdx; \
+    return u8RetUpper << 8 | u8RetLower; \
+  } \
+  static inline bool N##_end(const GENPIPE_STATE(N) *psState) { \
+    return psState->sStage.u8PhaseIdx == GENPIPE_PWMPHASE_END && IN##_end(&psState->sIn); \
+  } \
+  FORCE_INLINE_ATTR bool N##_get(GENPIPE_STATE(N) *psState, uint16_t *pu16Out) { \
+    SPwmXGenState *px = &psState->sStage; \
+    if (px->u8PhaseIdx == GENPIPE_PWMPHASE_END) { \
+      if (!IN##_get(&psState->sIn, &px->u8CurValue)) return false; \
+      px->u8PhaseIdx = 0; \
+    } \
+    uint8_t u8RetUpper = (px->u8PhaseIdx == 0) ? px->u8HiUpper : px->u8LoUpper; \
+    uint8_t u8RetLower = (px->u8PhaseIdx == 0) ? px->u8CurValue : px->u8PeriodLen - px->u8CurValue; \
+    ++px->u8PhaseIdx; \
+    *pu16Out = u8RetUpper << 8 | u8RetLower; \
+    return true; \
+  } \
+  static inline void N##_reset(GENPIPE_STATE(N) *psState) { \
+    IN##_reset(&psState->sIn); \
+    psState->sStage.u8PhaseIdx = GENPIPE_PWMPHASE_END; \
+  }
+
+  /**
+   * Stretch stage: lengthens the RMT entries generated by stage IN by M/N times,
+   * and splits the too long entries (see SStretchGenState).
+   * Output: uint16_t (RMT entry).
+   */
+#define GENPIPE_STRETCH_STAGE(N, IN) \
+  GENPIPE_STATE(N) { \
+    GENPIPE_STATE(IN) sIn; \
+    SStretchXGenState sStage; \
+  }; \
+  static inline void N##_init(GENPIPE_STATE(N) *psState, uint32_t u32Multiplier, uint32_t u32Divisor) { \
+    psState->sStage = genpipe_stretchx_init(u32Multiplier, u32Divisor); \
+  } \
+  static inline uint16_t N##_next(GENPIPE_STATE(N) *psState) { \
+    SStretchXGenState *px = &psState->sStage; \
+    if (0 == px->u32OutQueue) { \
+      uint16_t u16Val = IN##_next(&psState->sIn); \
+      px->bLevel = 0 < (u16Val & RMT_SIGNAL1); \
+      px->u32OutQueue = (u16Val & RMT_ENTRYMAX) * px->u32Multiplier / px->u32Divisor; \
+    } \
+    uint16_t u16Ret = (RMT_ENTRYMAX < px->u32OutQueue) ? RMT_ENTRYMAX : px->u32OutQueue; \
+    px->u32OutQueue -= u16Ret; \
+    return u16Ret | (px->bLevel ? RMT_SIGNAL1 : RMT_SIGNAL0); \
+  } \
+  static inline bool N##_end(const GENPIPE_STATE(N) *psState) { \
+    return psState->sStage.u32OutQueue == 0 && IN##_end(&psState->sIn); \
+  } \
+  FORCE_INLINE_ATTR bool N##_get(GENPIPE_STATE(N) *psState, uint16_t *pu16Out) { \
+    SStretchXGenState *px = &psState->sStage; \
+    if (0 == px->u32OutQueue) { \
+      uint16_t u16Val; \
+      if (!IN##_get(&psState->sIn, &u16Val)) return false; \
+      px->bLevel = 0 < (u16Val & RMT_SIGNAL1); \
+      px->u32OutQueue = (u16Val & RMT_ENTRYMAX) * px->u32Multiplier / px->u32Divisor; \
+    } \
+    uint16_t u16Ret = (RMT_ENTRYMAX < px->u32OutQueue) ? RMT_ENTRYMAX : px->u32OutQueue; \
+    px->u32OutQueue -= u16Ret; \
+    *pu16Out = u16Ret | (px->bLevel ? RMT_SIGNAL1 : RMT_SIGNAL0); \
+    return true; \
+  } \
+  static inline void N##_reset(GENPIPE_STATE(N) *psState) { \
+    IN##_reset(&psState->sIn); \
+    psState->sStage.u32OutQueue = 0; \
+  }
+
+  // ============= Batch templates ===============
+
+  /**
+   * Defines N_fill() for a byte stage (see FToByteFill).
+   */
+#define GENPIPE_BYTE_FILL(N) \
+  static inline uint32_t N##_fill(GENPIPE_STATE(N) *psState, uint8_t *pu8Dst, uint32_t u32Len) { \
+    uint32_t i = 0; \
+    while (i < u32Len && N##_get(psState, pu8Dst + i)) { \
+      ++i; \
+    } \
+    return i; \
+  }
+
+  /**
+   * Defines N_fill() for a word stage (see FToWordFill and U16Filler).
+   * The whole chain gets inlined into the loop body; the end of sequence is tested once
+   * per output value (by N_get()), not by a separate N_end() call walking the whole chain.
+   */
+#define GENPIPE_WORD_FILL(N) \
+  static inline uint32_t N##_fill(GENPIPE_STATE(N) *psState, uint32_t *pu32Dst, uint32_t u32Len) { \
+    uint32_t i = 0; \
+    for (; i < u32Len; ++i) { \
+      uint16_t u16Lo; \
+      uint16_t u16Hi; \
+      if (!N##_get(psState, &u16Lo)) break; \
+      if (!N##_get(psState, &u16Hi)) { \
+        pu32Dst[i++] = u16Lo; \
+        break; \
+      } \
+      pu32Dst[i] = u16Lo | ((uint32_t) u16Hi << 16); \
+    } \
+    return i; \
+  }
+
+  /**
+   * Defines a function table (static const SToWordFunctions VAR) for a word stage,
+   * so that the fused pipeline can be used where generators.h types are expected.
+   * GENPIPE_WORD_FILL(N) must precede this macro.
+   */
+#define GENPIPE_WORD_FUNCTIONS(N, VAR) \
+  static const SToWordFunctions VAR = { \
+    .fNext = (FToWordNext) N##_next, \
+    .fEnd = (FToXEnd) N##_end, \
+    .fReset = (FToXReset) N##_reset, \
+    .fFill = (FToWordFill) N##_fill \
+  };
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GENPIPE_H */
@@ -0,0 +1,101 @@
+/*
+ * Copyright 2025 SZIGETI János
+ *
+ * This file is part of Bilis ESP32 Basic, which is released under GNU General Public License.version 3.
+ * See LICENSE or <https://www.gnu.org/licenses/> for full license details.
+ */
+#include <stddef.h>
+#include "esp_attr.h"
+#include "rmtrx.h"
+
+// ============== Internal function declarations ==============
+static inline void _frame_end(SRmtRxStream *psStream);
+static inline bool _entry(SRmtRxStream *psStream, uint16_t u16Entry);
+static void _rxend_isr(void *pvParam);
+
+// ============== Internal functions ==============
+
+/**
+ * Closes the frame and notifies the decoder.
+ * @param psStream RX stream state descriptor.
+ */
+static inline void _frame_end(SRmtRxStream *psStream) {
+  psStream->bFrameEnd = true;
+  if (NULL != psStream->fEnd) {
+    psStream->fEnd(psStream->pvDecoder);
+  }
+}
+
+/**
+ * Passes a single entry to the decoder.
+ * @param psStream RX stream state descriptor.
+ * @param u16Entry RMT entry.
+ * @return The entry is the end of frame marker.
+ */
+static inline bool _entry(SRmtRxStream *psStream, uint16_t u16Entry) {
+  uint16_t u16Ticks = u16Entry & RMT_ENTRYMAX;
+  if (0 == u16Ticks) {
+    _frame_end(psStream);
+    return true;
+  }
+  psStream->fEntry(psStream->pvDecoder, 0 != (u16Entry & RMT_SIGNAL1), u16Ticks);
+  ++psStream->u32Entries;
+  return false;
+}
+
+IRAM_ATTR static void _rxend_isr(void *pvParam) {
+  ((SRmtRxStream*) pvParam)->bRxEnd = true;
+}
+
+// ============== Interface functions ==============
+
+SRmtRxStream rmtrx_init_stream(ERmtChannel eChannel, uint8_t u8Blocks,
+        FRmtRxEntry fEntry, FRmtRxEnd fEnd, void *pvDecoder) {
+  return (SRmtRxStream){
+    .eChannel = eChannel,
+    .u8Blocks = u8Blocks,
+    .u16ReadPos = 0,
+    .bFrameEnd = false,
+    .bRxEnd = false,
+    .u32Entries = 0,
+    .fEntry = fEntry,
+    .fEnd = fEnd,
+    .pvDecoder = pvDecoder};
+}
+
+void rmtrx_register_isr(SRmtRxStream *psStream) {
+  rmt_isr_register(psStream->eChannel, RMT_INT_RXEND, _rxend_isr, psStream);
+}
+
+void rmtrx_start(SRmtRxStream *psStream) {
+  psStream->u16ReadPos = 0;
+  psStream->bFrameEnd = false;
+  psStream->bRxEnd = false;
+  psStream->u32Entries = 0;
+  gpsRMT->asChConf[psStream->eChannel].r1.bMemOwner = 1;
+  rmt_start_rx(psStream->eChannel, true);
+}
+
+uint16_t rmtrx_drain(SRmtRxStream *psStream) {
+  uint16_t u16ChLen = psStream->u8Blocks * RMT_RAM_BLOCK_SIZE;
+  // RXEND is sampled first: once it is seen, every register is written
+  bool bRxEnd = psStream->bRxEnd;
+  uint16_t u16WritePos = bRxEnd ? u16ChLen : rmt_rx_pos(psStream->eChannel);
+  uint16_t u16Ret = 0;
+
+  if (u16ChLen < u16WritePos) {
+    u16WritePos = u16ChLen;
+  }
+  while (!psStream->bFrameEnd && psStream->u16ReadPos < u16WritePos) {
+    uint32_t u32Reg = *rmt_ram_addr(psStream->eChannel, psStream->u8Blocks, psStream->u16ReadPos);
+    ++psStream->u16ReadPos;
+    for (int i = 0; i < 2 && !_entry(psStream, u32Reg >> (16 * i)); ++i) {
+      ++u16Ret;
+    }
+  }
+  if (bRxEnd && !psStream->bFrameEnd) {
+    // the end marker is lost (the frame did not fit into the RAM range)
+    _frame_end(psStream);
+  }
+  return u16Ret;
+}
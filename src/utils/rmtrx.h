@@ -0,0 +1,104 @@
+/*
+ * Copyright 2025 SZIGETI János
+ *
+ * This file is part of Bilis ESP32 Basic, which is released under GNU General Public License.version 3.
+ * See LICENSE or <https://www.gnu.org/licenses/> for full license details.
+ */
+/** @file rmtrx.h
+ * Streaming RMT RX.
+ * Instead of decoding the received frame after RXEND, the received entries are
+ * drained from the RMT RAM while the reception is still ongoing, and passed to
+ * a decoder (an edge-by-edge state machine supplied by the user).
+ * The ESP32 receiver fills the RAM range of the channel linearly (it does not wrap around),
+ * hence a frame can have at most RMTRX_MAX_ENTRIES(u8Blocks) entries including the end of frame marker.
+ * The rest of a longer frame is lost, and the frame is closed when RXEND arrives.
+ * The ESP32 RMT does not have RX threshold interrupts, so rmtrx_drain() has to be invoked
+ * periodically (e.g. from the program cycle). The decoder runs only in the context of rmtrx_drain(),
+ * the RXEND interrupt handler merely flags the end of reception.
+ */
+#ifndef RMTRX_H
+#define RMTRX_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "rmt.h"
+
+  /// Max. number of entries (including the end of frame marker) in a frame received on u8Blocks RMT RAM blocks.
+#define RMTRX_MAX_ENTRIES(u8Blocks) (2U * RMT_RAM_BLOCK_SIZE * (u8Blocks))
+
+  // ============== Types ==============
+
+  /**
+   * Decoder callback: invoked for each received entry (in order of reception).
+   * pvDecoder is the decoder state, bLevel is the signal level, and u16Ticks is
+   * the duration of the entry (in RMT ticks).
+   */
+  typedef void (*FRmtRxEntry)(void *pvDecoder, bool bLevel, uint16_t u16Ticks);
+
+  /**
+   * Decoder callback: invoked when the end of frame marker (entry with 0 duration) is received.
+   */
+  typedef void (*FRmtRxEnd)(void *pvDecoder);
+
+  /**
+   * State descriptor of an RX stream.
+   */
+  typedef struct {
+    ERmtChannel eChannel; ///< RMT channel.
+    uint8_t u8Blocks; ///< Number of RMT RAM blocks assigned to the channel.
+    uint16_t u16ReadPos; ///< Relative index of the next register to drain.
+    bool bFrameEnd; ///< End of frame has been reached (the rest of the RAM is not drained).
+    volatile bool bRxEnd; ///< RXEND has arrived (set by the interrupt handler).
+    uint32_t u32Entries; ///< Number of entries passed to the decoder in the current frame.
+    FRmtRxEntry fEntry; ///< Decoder entry callback.
+    FRmtRxEnd fEnd; ///< Decoder end of frame callback (optional).
+    void *pvDecoder; ///< Decoder state descriptor.
+  } SRmtRxStream;
+
+  // ============== Interface functions ==============
+
+  /**
+   * Initializes an RX stream state descriptor.
+   * The RMT channel (divisor, idle threshold, filter, RAM blocks) has to be configured separately.
+   * @param eChannel RMT channel.
+   * @param u8Blocks Number of RMT RAM blocks assigned to the channel.
+   * @param fEntry Decoder entry callback.
+   * @param fEnd Decoder end of frame callback (may be NULL).
+   * @param pvDecoder Decoder state descriptor.
+   * @return Initialized state descriptor.
+   */
+  SRmtRxStream rmtrx_init_stream(ERmtChannel eChannel, uint8_t u8Blocks,
+          FRmtRxEntry fEntry, FRmtRxEnd fEnd, void *pvDecoder);
+
+  /**
+   * Registers the RXEND interrupt handler of the stream (it lets rmtrx_drain() drain the rest of the frame).
+   * rmt_isr_init() must preceed this function.
+   * @param psStream RX stream state descriptor.
+   */
+  void rmtrx_register_isr(SRmtRxStream *psStream);
+
+  /**
+   * Starts receiving a new frame: resets the stream and the receiver write address,
+   * sets RX memory ownership and enables the receiver.
+   * @param psStream RX stream state descriptor.
+   */
+  void rmtrx_start(SRmtRxStream *psStream);
+
+  /**
+   * Passes the entries of the completely received registers to the decoder.
+   * After RXEND, the rest of the frame is passed, and the frame is closed even if its end marker is lost.
+   * Not reentrant: invoke it from a single context (e.g. the program cycle), not from ISRs.
+   * @param psStream RX stream state descriptor.
+   * @return Number of entries passed to the decoder.
+   */
+  uint16_t rmtrx_drain(SRmtRxStream *psStream);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RMTRX_H */
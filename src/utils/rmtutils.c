@@ -13,6 +13,9 @@
 static uint32_t _pairgen_next(U16Generator pfGen, UniRel pfEnd, void *pvParam);
 static uint16_t _stretchgen_next(void *pvState);
 static bool _stretchgen_end(const void *pvState);
+static inline uint16_t _rlstretchgen_next(SRlStretchGenState *psState);
+static inline bool _rlstretchgen_end(const SRlStretchGenState *psState);
+static inline bool _entrypair_terminates(uint32_t u32Value);
 
 
 // ============== Internal functions ==============
@@ -57,6 +60,36 @@ static bool _stretchgen_end(const void *pvParam) {
   return psParam->fGenEnd(psParam->pvGenParam) && (psParam->u32OutQueue == 0);
 }
 
+/**
+ * Single step of the Run-length Stretch generator.
+ * The period length is multiplied by the fixed-point M/N value, the fraction part is dropped.
+ * @param psState State descriptor.
+ * @return Next output entry.
+ */
+static inline uint16_t _rlstretchgen_next(SRlStretchGenState *psState) {
+  if (0 == psState->u32OutQueue) {
+    uint16_t u16Val = psState->fGen(psState->pvGenParam);
+    psState->bLevel = 0 < (u16Val & RMT_SIGNAL1);
+    psState->u32OutQueue = ((u16Val & RMT_ENTRYMAX) * psState->u64MulFx) >> 32;
+  }
+  uint16_t u16Ret = (RMT_ENTRYMAX < psState->u32OutQueue) ? RMT_ENTRYMAX : psState->u32OutQueue;
+  psState->u32OutQueue -= u16Ret;
+  return u16Ret | (psState->bLevel ? RMT_SIGNAL1 : RMT_SIGNAL0);
+}
+
+static inline bool _rlstretchgen_end(const SRlStretchGenState *psState) {
+  return psState->u32OutQueue == 0 && psState->fGenEnd(psState->pvGenParam);
+}
+
+/**
+ * Tells if an RMT register value contains the tx termination entry (entry with 0 period).
+ * @param u32Value RMT register value (entry pair).
+ * @return Either of the entries is a terminating entry.
+ */
+static inline bool _entrypair_terminates(uint32_t u32Value) {
+  return (u32Value & RMT_ENTRYMAX) == 0 || (u32Value & (RMT_ENTRYMAX << 16)) == 0;
+}
+
 // ============== Interface functions ==============
 
 uint32_t rmtutils_copytoram(ERmtChannel eChannel, uint8_t u8Blocks, uint32_t u32Offset, uint32_t *pu32Src, uint32_t u32Len) {
@@ -81,8 +114,72 @@ SStretchGenState rmtutils_init_stretchgenstate(uint32_t u32Multiplier, uint32_t
   return sRet;
 }
 
+uint32_t rmtutils_stretchgen_fill(void *pvParam, uint32_t *pu32Dst, uint32_t u32Len) {
+  uint32_t i = 0;
+  while (i < u32Len && !_stretchgen_end(pvParam)) {
+    uint32_t u32Lo = _stretchgen_next(pvParam);
+    uint32_t u32Hi = _stretchgen_end(pvParam) ? 0 : _stretchgen_next(pvParam);
+    uint32_t u32Pair = u32Lo | (u32Hi << 16);
+    pu32Dst[i++] = u32Pair;
+    if (_entrypair_terminates(u32Pair)) {
+      break;
+    }
+  }
+  return i;
+}
+
 bool rmtutils_feed_tx_stretched(ERmtChannel eChannel, uint16_t *pu16MemPos, uint16_t u16Len, SStretchGenState *psSGenState) {
-  return rmtutils_feed_tx(eChannel, pu16MemPos, u16Len, _stretchgen_next, _stretchgen_end, psSGenState);
+  return rmtutils_feed_tx_fill(eChannel, pu16MemPos, u16Len, rmtutils_stretchgen_fill, psSGenState);
+}
+
+/**
+ * The multiplier is rounded up: for input periods below 2^15 and N < 2^17 the error
+ * is less than 1/N, thus the integer part of the product equals to (period * M) / N.
+ */
+SRlStretchGenState rmtutils_init_rlstretchgenstate(uint32_t u32Multiplier, uint32_t u32Divisor, U16Generator fGen,
+        UniRel fGenEnd, void *pvGenParam) {
+  SRlStretchGenState sRet = {
+    .fGen = fGen,
+    .fGenEnd = fGenEnd,
+    .pvGenParam = pvGenParam,
+    .u64MulFx = (((uint64_t) u32Multiplier << 32) + u32Divisor - 1) / u32Divisor,
+    .u32OutQueue = 0,
+    .bLevel = false
+  };
+  return sRet;
+}
+
+uint32_t rmtutils_rlstretchgen_fill(void *pvParam, uint32_t *pu32Dst, uint32_t u32Len) {
+  SRlStretchGenState *psState = (SRlStretchGenState*) pvParam;
+  uint32_t i = 0;
+  while (i < u32Len && !_rlstretchgen_end(psState)) {
+    if (2 * RMT_ENTRYMAX <= psState->u32OutQueue) {
+      // run of registers with two full-size chunks
+      uint32_t u32Chunk = RMT_ENTRYMAX | (psState->bLevel ? RMT_SIGNAL1 : RMT_SIGNAL0);
+      uint32_t u32Pair = u32Chunk | (u32Chunk << 16);
+      uint32_t u32Run = psState->u32OutQueue / (2 * RMT_ENTRYMAX);
+      if (u32Len - i < u32Run) {
+        u32Run = u32Len - i;
+      }
+      psState->u32OutQueue -= u32Run * 2 * RMT_ENTRYMAX;
+      for (uint32_t u32End = i + u32Run; i < u32End; ++i) {
+        pu32Dst[i] = u32Pair;
+      }
+    } else {
+      uint32_t u32Lo = _rlstretchgen_next(psState);
+      uint32_t u32Hi = _rlstretchgen_end(psState) ? 0 : _rlstretchgen_next(psState);
+      uint32_t u32Pair = u32Lo | (u32Hi << 16);
+      pu32Dst[i++] = u32Pair;
+      if (_entrypair_terminates(u32Pair)) {
+        break;
+      }
+    }
+  }
+  return i;
+}
+
+bool rmtutils_feed_tx_rlstretched(ERmtChannel eChannel, uint16_t *pu16MemPos, uint16_t u16Len, SRlStretchGenState *psSGenState) {
+  return rmtutils_feed_tx_fill(eChannel, pu16MemPos, u16Len, rmtutils_rlstretchgen_fill, psSGenState);
 }
 
 bool rmtutils_feed_tx(ERmtChannel eChannel, uint16_t *pu16MemPos, uint16_t u16Len, U16Generator pfGen, UniRel pfEnd, void *pvGen) {
@@ -96,7 +193,7 @@ bool rmtutils_feed_tx(ERmtChannel eChannel, uint16_t *pu16MemPos, uint16_t u16Le
     *rmt_ram_addr(eChannel, u8Blocks, *pu16MemPos + u16Written) = u32RegValue;
 
     // check if tx termination value was written
-    if ((u32RegValue & RMT_ENTRYMAX) == 0 || (u32RegValue & (RMT_ENTRYMAX << 16)) == 0) {
+    if (_entrypair_terminates(u32RegValue)) {
       bRet = true;
     }
   }
@@ -104,3 +201,35 @@ bool rmtutils_feed_tx(ERmtChannel eChannel, uint16_t *pu16MemPos, uint16_t u16Le
   *pu16MemPos %= (u8Blocks * RMT_RAM_BLOCK_SIZE);
   return bRet;
 }
+
+bool rmtutils_feed_tx_fill(ERmtChannel eChannel, uint16_t *pu16MemPos, uint16_t u16Len, U16Filler pfFill, void *pvGen) {
+  uint8_t u8Blocks = gpsRMT->asChConf[eChannel].r0.u4MemSize;
+  uint16_t u16ChLen = u8Blocks * RMT_RAM_BLOCK_SIZE;
+  uint16_t u16Written = 0; // counter for written registers
+  bool bRet = false;
+
+  while (u16Written < u16Len && !bRet) {
+    uint16_t u16Pos = (*pu16MemPos + u16Written) % u16ChLen;
+    uint32_t u32RamIdx = RMT_RAM_BLOCK_SIZE * eChannel + u16Pos;
+    // contiguous range: must not cross neither the end of channel RAM, nor the end of the whole RMT RAM
+    uint16_t u16Span = u16Len - u16Written;
+    if (u16ChLen - u16Pos < u16Span) u16Span = u16ChLen - u16Pos;
+    if (RMT_CHANNEL_NUM * RMT_RAM_BLOCK_SIZE - u32RamIdx % (RMT_CHANNEL_NUM * RMT_RAM_BLOCK_SIZE) < u16Span) {
+      u16Span = RMT_CHANNEL_NUM * RMT_RAM_BLOCK_SIZE - u32RamIdx % (RMT_CHANNEL_NUM * RMT_RAM_BLOCK_SIZE);
+    }
+    uint32_t *pu32Dst = (uint32_t*) rmt_ram_addr(eChannel, u8Blocks, u16Pos);
+
+    uint32_t u32Filled = pfFill(pvGen, pu32Dst, u16Span);
+    u16Written += u32Filled;
+
+    // the filler has stopped after a terminating register, or at the end of sequence: a 0 register ends the TX
+    if (u32Filled < u16Span) {
+      pu32Dst[u32Filled] = 0;
+      ++u16Written;
+      bRet = true;
+    }
+  }
+  *pu16MemPos += u16Written;
+  *pu16MemPos %= u16ChLen;
+  return bRet;
+}
@@ -23,6 +23,17 @@ extern "C" {
    * of the generator (pvParam) to the generator function.
    */
   typedef uint16_t(*U16Generator)(void *pvParam);
+  /**
+   * Batch variant of U16Generator: the filler writes at most u32Len RMT registers
+   * (pairs of uint16_t values, the first value in bits 0..15) into pu32Dst in a single call.
+   * If the sequence ends after the first value of a pair, bits 16..31 are 0.
+   * The filler stops after a register containing a 0 period entry (it terminates the RMT TX),
+   * so the caller does not have to read the written registers back.
+   * Returns the number of written registers, including the terminating one
+   * (less than u32Len only if the end of sequence or a terminating register is reached).
+   * Note, the signature matches FToWordFill of generators.h (those fill functions do not stop at 0 periods).
+   */
+  typedef uint32_t(*U16Filler)(void *pvParam, uint32_t *pu32Dst, uint32_t u32Len);
   /**
    * Generalized unary relation, taking a single argument.
    */
@@ -44,6 +55,22 @@ extern "C" {
     bool bLevel; ///< Current output entry signal level.
   } SStretchGenState;
 
+  /**
+   * State descriptor of Run-length Stretch Generator.
+   * Same as the Stretch generator, but the M/N multiplier is stored as a precomputed
+   * 32.32 fixed-point value (no division per input entry), and the filler function
+   * emits the full-size (RMT_ENTRYMAX) chunks of a long period in one batch.
+   * The output is identical to the output of the Stretch generator if N < 2^17.
+   */
+  typedef struct {
+    U16Generator fGen; ///< Underlying entry generator.
+    UniRel fGenEnd; ///< Sequence end indicator function for the underlying generator.
+    void *pvGenParam; ///< State descriptor of the underlying generator.
+    uint64_t u64MulFx; ///< ceil(2^32 * M / N): the M/N Period length multiplier in 32.32 fixed-point format.
+    uint32_t u32OutQueue; ///< Remaining period length.
+    bool bLevel; ///< Current output entry signal level.
+  } SRlStretchGenState;
+
   // ============== Interface functions ==============
   /**
    * Copies an array of uint32_t values into RMT RAM registers.
@@ -60,7 +87,7 @@ extern "C" {
           UniRel fGenEnd, void *pvGenParam);
 
   /**
-   * Adapter function to rmtutils_feed_tx().
+   * Adapter function to rmtutils_feed_tx_fill().
    * The feeder will not take directly the values from the U16Generator, but via a Stretch generator.
    * @param eChannel
    * @param pu16MemPos
@@ -70,6 +97,28 @@ extern "C" {
    */
   bool rmtutils_feed_tx_stretched(ERmtChannel eChannel, uint16_t *pu16MemPos, uint16_t u16Len, SStretchGenState *psSGenState);
 
+  /**
+   * Initializes the state descriptor of a Run-length Stretch generator.
+   * @param u32Multiplier M value of the M/N Period length multiplier (M/N < 2^17).
+   * @param u32Divisor N value of the M/N Period length multiplier.
+   * @param fGen Underlying entry generator.
+   * @param fGenEnd Sequence end indicator function for the underlying generator.
+   * @param pvGenParam State descriptor of the underlying generator.
+   * @return Initialized state descriptor.
+   */
+  SRlStretchGenState rmtutils_init_rlstretchgenstate(uint32_t u32Multiplier, uint32_t u32Divisor, U16Generator fGen,
+          UniRel fGenEnd, void *pvGenParam);
+
+  /**
+   * Adapter function to rmtutils_feed_tx_fill() using a Run-length Stretch generator.
+   * @param eChannel Identifies the RMT channel.
+   * @param pu16MemPos Input/output parameter, pointer to the memory offset value.
+   * @param u16Len Amount of registers(!) (pair of RMT entries) to write.
+   * @param psSGenState State descriptor of the Run-length Stretch generator.
+   * @return Terminating entry has been written.
+   */
+  bool rmtutils_feed_tx_rlstretched(ERmtChannel eChannel, uint16_t *pu16MemPos, uint16_t u16Len, SRlStretchGenState *psSGenState);
+
   /**
    * RMT RAM block feeder function, taking RMT entries from pfGen.
    * @param eChannel Identifies the RMT channel.
@@ -83,6 +132,44 @@ extern "C" {
    */
   bool rmtutils_feed_tx(ERmtChannel eChannel, uint16_t *pu16MemPos, uint16_t u16Len, U16Generator pfGen, UniRel pfEnd, void *pvGen);
 
+  /**
+   * RMT RAM block feeder function, taking RMT entry pairs from a batch filler.
+   * The filler writes directly into the RMT RAM, it is invoked once per contiguous RAM range
+   * (the range to write is split at the end of the channel RAM and at the end of the whole RMT RAM),
+   * until u16Len registers are written or the filler stops. If the filler returns fewer registers
+   * than requested (see U16Filler), a 0 register is written after them.
+   * A 0 period in the last register of a range does not stop the feeding (the RMT stops there anyway).
+   * @param eChannel Identifies the RMT channel.
+   * @param pu16MemPos Input/output parameter, pointer to the memory offset value.
+   * In: where to start writing the memory, out: here can you continue writing the memory.
+   * @param u16Len Amount of registers(!) (pair of RMT entries) to write.
+   * @param pfFill Underlying filler to take the RMT entry pairs from.
+   * @param pvGen Filler state descriptor to pass to pfFill.
+   * @return Terminating entry has been written (the memory offset stops after the 0 register).
+   */
+  bool rmtutils_feed_tx_fill(ERmtChannel eChannel, uint16_t *pu16MemPos, uint16_t u16Len, U16Filler pfFill, void *pvGen);
+
+  /**
+   * Filler function of the Stretch generator (see U16Filler).
+   * The underlying generator is still invoked entry-by-entry, but only once per input entry.
+   * @param pvParam SStretchGenState pointer.
+   * @param pu32Dst Destination of the entry pairs.
+   * @param u32Len Capacity of the destination (number of registers).
+   * @return Number of written registers.
+   */
+  uint32_t rmtutils_stretchgen_fill(void *pvParam, uint32_t *pu32Dst, uint32_t u32Len);
+
+  /**
+   * Filler function of the Run-length Stretch generator (see U16Filler).
+   * Registers containing two full-size chunks of the same period are written without
+   * invoking the underlying generator.
+   * @param pvParam SRlStretchGenState pointer.
+   * @param pu32Dst Destination of the entry pairs.
+   * @param u32Len Capacity of the destination (number of registers).
+   * @return Number of written registers.
+   */
+  uint32_t rmtutils_rlstretchgen_fill(void *pvParam, uint32_t *pu32Dst, uint32_t u32Len);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,126 @@
+/*
+ * Copyright 2025 SZIGETI János
+ *
+ * This file is part of Bilis ESP32 Basic, which is released under GNU General Public License.version 3.
+ * See LICENSE or <https://www.gnu.org/licenses/> for full license details.
+ */
+
+#include <string.h>
+#include "shell.h"
+
+// ================ Local function declarations =================
+static inline bool _is_space(char c);
+static void _help(const SShell *psShell);
+static void _execute(SShell *psShell);
+
+// ==================== Implementation ================
+
+static inline bool _is_space(char c) {
+  return c == ' ' || c == '\t';
+}
+
+static void _help(const SShell *psShell) {
+  uart_printf(psShell->psUART, "help\r\n");
+  for (uint8_t i = 0; i < psShell->u8CmdNum; ++i) {
+    uart_printf(psShell->psUART, "%s %s\r\n", psShell->psCmds[i].pcName, psShell->psCmds[i].pcHelp);
+  }
+}
+
+/**
+ * Tokenizes the line buffer and executes its command.
+ * @param psShell Shell state descriptor.
+ */
+static void _execute(SShell *psShell) {
+  char *apcArgv[SHELL_MAXARGS];
+
+  psShell->acLine[psShell->u8Len] = '\0';
+  uint8_t u8Argc = shell_tokenize(psShell->acLine, apcArgv, SHELL_MAXARGS);
+  if (0 == u8Argc) {
+    return;
+  }
+  if (0 == strcmp(apcArgv[0], "help")) {
+    _help(psShell);
+    return;
+  }
+  for (uint8_t i = 0; i < psShell->u8CmdNum; ++i) {
+    if (0 == strcmp(apcArgv[0], psShell->psCmds[i].pcName)) {
+      psShell->psCmds[i].fHandler(psShell->psCmds[i].pvArg, u8Argc, apcArgv);
+      return;
+    }
+  }
+  uart_printf(psShell->psUART, "Unknown command: %s\r\n", apcArgv[0]);
+}
+
+// ============== Interface functions ==============
+
+SShell shell_init(SUartRxRing *psRx, UART_Type *psUART, const SShellCmd *psCmds, uint8_t u8CmdNum) {
+  SShell sRet;
+  memset(&sRet, 0, sizeof (sRet));
+  sRet.psRx = psRx;
+  sRet.psUART = psUART;
+  sRet.psCmds = psCmds;
+  sRet.u8CmdNum = u8CmdNum;
+  return sRet;
+}
+
+uint8_t shell_tokenize(char *pcLine, char **ppcArgv, uint8_t u8MaxArgs) {
+  uint8_t u8Argc = 0;
+  char *pc = pcLine;
+
+  while (u8Argc < u8MaxArgs) {
+    while (_is_space(*pc)) {
+      ++pc;
+    }
+    if (!*pc) {
+      break;
+    }
+    ppcArgv[u8Argc++] = pc;
+    while (*pc && !_is_space(*pc)) {
+      ++pc;
+    }
+    if (*pc) {
+      *(pc++) = '\0';
+    }
+  }
+  return u8Argc;
+}
+
+bool shell_parse_u32(const char *pcToken, uint32_t *pu32Value) {
+  uint32_t u32Value = 0;
+
+  if (!*pcToken) {
+    return false;
+  }
+  for (; *pcToken; ++pcToken) {
+    if (*pcToken < '0' || '9' < *pcToken || (UINT32_MAX - (*pcToken - '0')) / 10 < u32Value) {
+      return false;
+    }
+    u32Value = 10 * u32Value + (*pcToken - '0');
+  }
+  *pu32Value = u32Value;
+  return true;
+}
+
+void shell_cycle(SShell *psShell) {
+  char c;
+
+  while (uart_rx_getc(psShell->psRx, &c)) {
+    if (c == '\r' || c == '\n') {
+      if (psShell->bOverflow) {
+        uart_printf(psShell->psUART, "Line too long\r\n");
+      } else {
+        _execute(psShell);
+      }
+      psShell->u8Len = 0;
+      psShell->bOverflow = false;
+    } else if (c == '\b' || c == 0x7F) {
+      if (0 < psShell->u8Len) {
+        --psShell->u8Len;
+      }
+    } else if (psShell->u8Len < SHELL_LINE_LEN) {
+      psShell->acLine[psShell->u8Len++] = c;
+    } else {
+      psShell->bOverflow = true;
+    }
+  }
+}
@@ -0,0 +1,98 @@
+/*
+ * Copyright 2025 SZIGETI János
+ *
+ * This file is part of Bilis ESP32 Basic, which is released under GNU General Public License.version 3.
+ * See LICENSE or <https://www.gnu.org/licenses/> for full license details.
+ */
+/** @file shell.h
+ * Line oriented command shell on a UART.
+ * The received bytes are collected into a line buffer; a complete line is split into
+ * whitespace separated tokens in place (the separators are overwritten with '\0', the
+ * arguments point into the line buffer), and the handler of the command (the first token)
+ * is looked up in a registration table. Nothing is allocated or copied while parsing.
+ * The built-in "help" command lists the registered commands.
+ */
+#ifndef SHELL_H
+#define SHELL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "uartutils.h"
+
+#define SHELL_LINE_LEN 80U  ///< Max. length of a command line.
+#define SHELL_MAXARGS 8U    ///< Max. number of tokens (command name included).
+
+  /**
+   * Command handler.
+   * @param pvArg Argument of the registration entry.
+   * @param u8Argc Number of tokens (command name included).
+   * @param ppcArgv Tokens (ppcArgv[0] is the command name).
+   */
+  typedef void (*FShellCmd)(void *pvArg, uint8_t u8Argc, char *const *ppcArgv);
+
+  /**
+   * Registration entry of a command.
+   */
+  typedef struct {
+    const char *pcName;   ///< Command name.
+    const char *pcHelp;   ///< One-line description (arguments).
+    FShellCmd fHandler;
+    void *pvArg;          ///< Passed to the handler.
+  } SShellCmd;
+
+  /**
+   * State descriptor of the shell.
+   */
+  typedef struct {
+    SUartRxRing *psRx;          ///< Input.
+    UART_Type *psUART;          ///< Output (responses of the shell).
+    const SShellCmd *psCmds;    ///< Registration table.
+    uint8_t u8CmdNum;           ///< Number of entries of the registration table.
+    char acLine[SHELL_LINE_LEN + 1]; ///< Line buffer.
+    uint8_t u8Len;              ///< Length of the line received so far.
+    bool bOverflow;             ///< The current line is too long (it is discarded).
+  } SShell;
+
+  /**
+   * Initializes the shell.
+   * @param psRx RX ring of the input (started).
+   * @param psUART Output UART.
+   * @param psCmds Registration table of the commands (must be valid while the shell is used).
+   * @param u8CmdNum Number of entries of the registration table.
+   * @return Initialized shell state descriptor.
+   */
+  SShell shell_init(SUartRxRing *psRx, UART_Type *psUART, const SShellCmd *psCmds, uint8_t u8CmdNum);
+
+  /**
+   * Splits a line into tokens in place.
+   * @param pcLine Zero terminated line (the separators are overwritten).
+   * @param ppcArgv Destination of the tokens.
+   * @param u8MaxArgs Max. number of tokens (the rest of the line is ignored).
+   * @return Number of tokens.
+   */
+  uint8_t shell_tokenize(char *pcLine, char **ppcArgv, uint8_t u8MaxArgs);
+
+  /**
+   * Parses an unsigned decimal number.
+   * @param pcToken Token.
+   * @param pu32Value Destination.
+   * @return The token is a valid number.
+   */
+  bool shell_parse_u32(const char *pcToken, uint32_t *pu32Value);
+
+  /**
+   * Processes the received bytes: executes the commands of the completed lines.
+   * Both CR and LF terminate a line, backspace deletes the last character.
+   * @param psShell Shell state descriptor.
+   */
+  void shell_cycle(SShell *psShell);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SHELL_H */
@@ -0,0 +1,178 @@
+/*
+ * Copyright 2025 SZIGETI János
+ *
+ * This file is part of Bilis ESP32 Basic, which is released under GNU General Public License.version 3.
+ * See LICENSE or <https://www.gnu.org/licenses/> for full license details.
+ */
+#include <stddef.h>
+#include <string.h>
+#include "timeseries.h"
+
+// ============== Internal function declarations ==============
+static inline uint16_t _ring_push(STsRing *psRing, uint16_t u16Len);
+static inline uint16_t _ring_idx(const STsRing *psRing, uint16_t u16Len, uint16_t u16Idx);
+static inline void _aggr_add(STsAggregate *psAggr, const STsAggregate *psItem);
+static void _bucket_add(STsAggregate *psAcc, STsRing *psRing, STsAggregate *asBuckets, uint16_t u16Len,
+        uint32_t u32msPeriod, uint32_t u32msTime, int32_t i32Value);
+
+// ============== Internal functions ==============
+
+/**
+ * Reserves the next item of a ring (overwriting the oldest one, if the ring is full).
+ * @param psRing Ring indices.
+ * @param u16Len Capacity of the ring.
+ * @return Index of the item to write.
+ */
+static inline uint16_t _ring_push(STsRing *psRing, uint16_t u16Len) {
+  uint16_t u16Ret = psRing->u16Head;
+  psRing->u16Head = (psRing->u16Head + 1) % u16Len;
+  if (psRing->u16Count < u16Len) {
+    ++psRing->u16Count;
+  }
+  return u16Ret;
+}
+
+/**
+ * Array index of a ring item.
+ * @param psRing Ring indices.
+ * @param u16Len Capacity of the ring.
+ * @param u16Idx Index of the item: 0 is the most recent one (must be less than u16Count).
+ * @return Array index.
+ */
+static inline uint16_t _ring_idx(const STsRing *psRing, uint16_t u16Len, uint16_t u16Idx) {
+  return (psRing->u16Head + u16Len - 1 - u16Idx) % u16Len;
+}
+
+/**
+ * Merges an aggregate into another one.
+ * @param psAggr Aggregate to update.
+ * @param psItem Aggregate to merge.
+ */
+static inline void _aggr_add(STsAggregate *psAggr, const STsAggregate *psItem) {
+  if (0 == psAggr->u32Count) {
+    *psAggr = *psItem;
+    return;
+  }
+  if (psItem->i32Min < psAggr->i32Min)
+    psAggr->i32Min = psItem->i32Min;
+  if (psAggr->i32Max < psItem->i32Max)
+    psAggr->i32Max = psItem->i32Max;
+  psAggr->u32Count += psItem->u32Count;
+  psAggr->i64Sum += psItem->i64Sum;
+}
+
+/**
+ * Adds a sample to the open bucket of a tier. If the sample belongs to a later bucket,
+ * the open bucket is pushed into the ring first.
+ * Buckets are aligned to the multiples of the period (wrap-around of the timestamps shifts the grid).
+ * @param psAcc Open bucket.
+ * @param psRing Ring indices of the tier.
+ * @param asBuckets Ring items of the tier.
+ * @param u16Len Capacity of the ring.
+ * @param u32msPeriod Bucket length.
+ * @param u32msTime Timestamp of the sample.
+ * @param i32Value Value of the sample.
+ */
+static void _bucket_add(STsAggregate *psAcc, STsRing *psRing, STsAggregate *asBuckets, uint16_t u16Len,
+        uint32_t u32msPeriod, uint32_t u32msTime, int32_t i32Value) {
+  uint32_t u32msStart = u32msTime - (u32msTime % u32msPeriod);
+  if (0 != psAcc->u32Count) {
+    uint32_t u32msElapsed = u32msTime - psAcc->u32msStart;
+    if (u32msElapsed < u32msPeriod) {
+      _aggr_add(psAcc, &(STsAggregate){.i32Min = i32Value, .i32Max = i32Value, .u32Count = 1, .i64Sum = i32Value});
+      return;
+    }
+    asBuckets[_ring_push(psRing, u16Len)] = *psAcc;
+    u32msStart = u32msTime - (u32msElapsed % u32msPeriod);
+  }
+  *psAcc = (STsAggregate){
+    .u32msStart = u32msStart,
+    .i32Min = i32Value,
+    .i32Max = i32Value,
+    .u32Count = 1,
+    .i64Sum = i32Value};
+}
+
+// ============== Interface functions ==============
+
+void timeseries_init(STimeSeries *psSeries) {
+  memset(psSeries, 0, sizeof (*psSeries));
+}
+
+void timeseries_add(STimeSeries *psSeries, uint32_t u32msTime, int32_t i32Value) {
+  psSeries->asRaw[_ring_push(&psSeries->sRawRing, TIMESERIES_RAW_LEN)] = (STsSample){
+    .u32msTime = u32msTime,
+    .i32Value = i32Value};
+  _bucket_add(&psSeries->sSecAcc, &psSeries->sSecRing, psSeries->asSec, TIMESERIES_SEC_LEN,
+          TIMESERIES_SEC_MS, u32msTime, i32Value);
+  _bucket_add(&psSeries->sMinAcc, &psSeries->sMinRing, psSeries->asMin, TIMESERIES_MIN_LEN,
+          TIMESERIES_MIN_MS, u32msTime, i32Value);
+}
+
+uint16_t timeseries_count(const STimeSeries *psSeries, ETsTier eTier) {
+  switch (eTier) {
+    case TS_TIER_RAW:
+      return psSeries->sRawRing.u16Count;
+    case TS_TIER_SEC:
+      return psSeries->sSecRing.u16Count;
+    case TS_TIER_MIN:
+      return psSeries->sMinRing.u16Count;
+    default:
+      return 0;
+  }
+}
+
+bool timeseries_get(const STimeSeries *psSeries, ETsTier eTier, uint16_t u16Idx, STsAggregate *psResult) {
+  if (timeseries_count(psSeries, eTier) <= u16Idx) {
+    return false;
+  }
+  switch (eTier) {
+    case TS_TIER_RAW:
+    {
+      const STsSample *psSample = &psSeries->asRaw[_ring_idx(&psSeries->sRawRing, TIMESERIES_RAW_LEN, u16Idx)];
+      *psResult = (STsAggregate){
+        .u32msStart = psSample->u32msTime,
+        .i32Min = psSample->i32Value,
+        .i32Max = psSample->i32Value,
+        .u32Count = 1,
+        .i64Sum = psSample->i32Value};
+      break;
+    }
+    case TS_TIER_SEC:
+      *psResult = psSeries->asSec[_ring_idx(&psSeries->sSecRing, TIMESERIES_SEC_LEN, u16Idx)];
+      break;
+    case TS_TIER_MIN:
+      *psResult = psSeries->asMin[_ring_idx(&psSeries->sMinRing, TIMESERIES_MIN_LEN, u16Idx)];
+      break;
+    default:
+      return false;
+  }
+  return true;
+}
+
+bool timeseries_window(const STimeSeries *psSeries, ETsTier eTier, uint32_t u32msFrom, uint32_t u32msTo,
+        STsAggregate *psResult) {
+  uint32_t u32msLen = u32msTo - u32msFrom;
+  STsAggregate sItem;
+  *psResult = (STsAggregate){.u32Count = 0};
+
+  const STsAggregate *psOpen = NULL;
+  if (TS_TIER_SEC == eTier) {
+    psOpen = &psSeries->sSecAcc;
+  } else if (TS_TIER_MIN == eTier) {
+    psOpen = &psSeries->sMinAcc;
+  }
+  if (NULL != psOpen && 0 != psOpen->u32Count && (psOpen->u32msStart - u32msFrom) < u32msLen) {
+    _aggr_add(psResult, psOpen);
+  }
+  // from the most recent item backwards, so the start of the result is the oldest one
+  uint16_t u16Cnt = timeseries_count(psSeries, eTier);
+  for (uint16_t i = 0; i < u16Cnt && timeseries_get(psSeries, eTier, i, &sItem); ++i) {
+    if ((sItem.u32msStart - u32msFrom) < u32msLen) {
+      uint32_t u32msStart = sItem.u32msStart;
+      _aggr_add(psResult, &sItem);
+      psResult->u32msStart = u32msStart;
+    }
+  }
+  return 0 != psResult->u32Count;
+}
@@ -0,0 +1,144 @@
+/*
+ * Copyright 2025 SZIGETI János
+ *
+ * This file is part of Bilis ESP32 Basic, which is released under GNU General Public License.version 3.
+ * See LICENSE or <https://www.gnu.org/licenses/> for full license details.
+ */
+/** @file timeseries.h
+ * Fixed-memory time-series store for sensor readings.
+ * Each channel (STimeSeries) keeps the last TIMESERIES_RAW_LEN raw samples, and
+ * min / max / mean aggregates of the last TIMESERIES_SEC_LEN seconds and
+ * TIMESERIES_MIN_LEN minutes in rings, thus the memory bound is known at compile time.
+ * Values are fixed-point integers, their unit is up to the user (e.g. 0.01 °C, mLx).
+ * Timestamps are milliseconds; the uint32_t timestamps may wrap around, but a single query window
+ * must be shorter than ~49 days.
+ */
+#ifndef TIMESERIES_H
+#define TIMESERIES_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define TIMESERIES_RAW_LEN 16U ///< Number of raw samples stored per channel.
+#define TIMESERIES_SEC_LEN 60U ///< Number of 1 s aggregates stored per channel.
+#define TIMESERIES_MIN_LEN 60U ///< Number of 1 min aggregates stored per channel.
+
+#define TIMESERIES_SEC_MS 1000U
+#define TIMESERIES_MIN_MS 60000U
+
+  // ============== Types ==============
+
+  typedef enum {
+    TS_TIER_RAW, ///< Raw samples.
+    TS_TIER_SEC, ///< 1 s aggregates.
+    TS_TIER_MIN, ///< 1 min aggregates.
+  } ETsTier;
+
+  /**
+   * Raw sample.
+   */
+  typedef struct {
+    uint32_t u32msTime; ///< Timestamp.
+    int32_t i32Value; ///< Value.
+  } STsSample;
+
+  /**
+   * Aggregate of samples (a single raw sample is an aggregate of count 1).
+   */
+  typedef struct {
+    uint32_t u32msStart; ///< Timestamp of the bucket (or the first sample).
+    int32_t i32Min; ///< Minimum value.
+    int32_t i32Max; ///< Maximum value.
+    uint32_t u32Count; ///< Number of samples.
+    int64_t i64Sum; ///< Sum of the values (mean = i64Sum / u32Count).
+  } STsAggregate;
+
+  /**
+   * Ring indices: u16Head is the index of the next item to write.
+   */
+  typedef struct {
+    uint16_t u16Head;
+    uint16_t u16Count;
+  } STsRing;
+
+  /**
+   * Time-series store of a single channel.
+   */
+  typedef struct {
+    STsSample asRaw[TIMESERIES_RAW_LEN]; ///< Raw sample ring.
+    STsAggregate asSec[TIMESERIES_SEC_LEN]; ///< Closed 1 s bucket ring.
+    STsAggregate asMin[TIMESERIES_MIN_LEN]; ///< Closed 1 min bucket ring.
+    STsRing sRawRing;
+    STsRing sSecRing;
+    STsRing sMinRing;
+    STsAggregate sSecAcc; ///< Currently open 1 s bucket (u32Count = 0, if there is no open bucket).
+    STsAggregate sMinAcc; ///< Currently open 1 min bucket.
+  } STimeSeries;
+
+  // ============== Interface functions ==============
+
+  /**
+   * Mean value of an aggregate.
+   * @param psAggr Aggregate.
+   * @return Mean value (0 if the aggregate is empty).
+   */
+  static inline int32_t timeseries_mean(const STsAggregate *psAggr) {
+    return psAggr->u32Count ? (int32_t) (psAggr->i64Sum / (int64_t) psAggr->u32Count) : 0;
+  }
+
+  /**
+   * Clears a channel.
+   * @param psSeries Time-series of the channel.
+   */
+  void timeseries_init(STimeSeries *psSeries);
+
+  /**
+   * Stores a sample. The timestamps must be non-decreasing.
+   * The open 1 s / 1 min buckets are closed (and pushed into their rings),
+   * if the sample belongs to a later bucket.
+   * @param psSeries Time-series of the channel.
+   * @param u32msTime Timestamp of the sample.
+   * @param i32Value Value of the sample.
+   */
+  void timeseries_add(STimeSeries *psSeries, uint32_t u32msTime, int32_t i32Value);
+
+  /**
+   * Number of stored items of a tier (the open bucket is not included).
+   * @param psSeries Time-series of the channel.
+   * @param eTier Tier.
+   * @return Number of items.
+   */
+  uint16_t timeseries_count(const STimeSeries *psSeries, ETsTier eTier);
+
+  /**
+   * Reads a stored item of a tier.
+   * @param psSeries Time-series of the channel.
+   * @param eTier Tier.
+   * @param u16Idx Index of the item: 0 is the most recent one.
+   * @param psResult Output: the item (raw samples are converted into aggregates).
+   * @return The item exists.
+   */
+  bool timeseries_get(const STimeSeries *psSeries, ETsTier eTier, uint16_t u16Idx, STsAggregate *psResult);
+
+  /**
+   * Aggregates the stored items of a tier in the [u32msFrom, u32msTo) window.
+   * For the 1 s and 1 min tiers, the open bucket is also included (if its start is in the window).
+   * @param psSeries Time-series of the channel.
+   * @param eTier Tier (the coarser the tier, the longer the window can be).
+   * @param u32msFrom Start of the window.
+   * @param u32msTo End of the window.
+   * @param psResult Output: the aggregate (u32msStart is the timestamp of the first item).
+   * @return The window is not empty.
+   */
+  bool timeseries_window(const STimeSeries *psSeries, ETsTier eTier, uint32_t u32msFrom, uint32_t u32msTo,
+          STsAggregate *psResult);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TIMESERIES_H */
@@ -0,0 +1,89 @@
+/*
+ * Copyright 2025 SZIGETI János
+ *
+ * This file is part of Bilis ESP32 Basic, which is released under GNU General Public License.version 3.
+ * See LICENSE or <https://www.gnu.org/licenses/> for full license details.
+ */
+
+#include "esp_attr.h"
+#include "trace.h"
+
+// ================ Local function declarations =================
+static inline void _put(STraceLog *psLog, uint16_t *pu16Pos, uint8_t *pu8Sum, uint8_t u8Value);
+
+// ==================== Implementation ================
+
+static inline void _put(STraceLog *psLog, uint16_t *pu16Pos, uint8_t *pu8Sum, uint8_t u8Value) {
+  psLog->pu8Buf[(*pu16Pos)++ & psLog->u16Mask] = u8Value;
+  *pu8Sum += u8Value;
+}
+
+// ============== Interface functions ==============
+
+STraceLog trace_init(uint8_t *pu8Buf, uint16_t u16Size) {
+  STraceLog sRet = {
+    .pu8Buf = pu8Buf,
+    .u16Mask = u16Size - 1,
+    .u16Head = 0,
+    .u16Tail = 0,
+    .u32Dropped = 0
+  };
+  return sRet;
+}
+
+bool IRAM_ATTR trace_record(STraceLog *psLog, uint16_t u16FmtId, uint8_t u8Argc, const uint32_t *pu32Args) {
+  uint16_t u16Pos = psLog->u16Head;
+  uint8_t u8Sum = 0;
+
+  if (TRACE_MAXARGS < u8Argc) {
+    u8Argc = TRACE_MAXARGS;
+  }
+  if (psLog->u16Mask + 1 - (uint16_t) (u16Pos - psLog->u16Tail) < TRACE_FRAME_LEN(u8Argc)) {
+    ++psLog->u32Dropped;
+    return false;
+  }
+  psLog->pu8Buf[u16Pos++ & psLog->u16Mask] = TRACE_SYNC;
+  _put(psLog, &u16Pos, &u8Sum, u8Argc);
+  _put(psLog, &u16Pos, &u8Sum, u16FmtId & 0xFF);
+  _put(psLog, &u16Pos, &u8Sum, u16FmtId >> 8);
+  for (uint8_t i = 0; i < u8Argc; ++i) {
+    uint32_t u32Arg = pu32Args[i];
+    for (uint8_t j = 0; j < 4; ++j, u32Arg >>= 8) {
+      _put(psLog, &u16Pos, &u8Sum, u32Arg & 0xFF);
+    }
+  }
+  psLog->pu8Buf[u16Pos++ & psLog->u16Mask] = u8Sum;
+  psLog->u16Head = u16Pos;
+  return true;
+}
+
+uint16_t trace_flush(STraceLog *psLog, SUartTxRing *psRing) {
+  uint16_t u16Moved = 0;
+  uint16_t u16Used = psLog->u16Head - psLog->u16Tail;
+  uint16_t u16Free = uart_tx_free(psRing);
+  uint16_t u16Len = 0;
+
+  // whole frames only: the length of a frame is given by its argument count (the byte after TRACE_SYNC)
+  while (u16Len < u16Used) {
+    uint8_t u8Argc = psLog->pu8Buf[(psLog->u16Tail + u16Len + 1) & psLog->u16Mask];
+    uint16_t u16FrameLen = TRACE_FRAME_LEN(u8Argc);
+    if (u16Free < u16Len + u16FrameLen) {
+      break;
+    }
+    u16Len += u16FrameLen;
+  }
+
+  // at most two contiguous chunks (before and after the end of the buffer)
+  while (0 < u16Len) {
+    uint16_t u16Begin = psLog->u16Tail & psLog->u16Mask;
+    uint16_t u16Chunk = psLog->u16Mask + 1 - u16Begin;
+    if (u16Len < u16Chunk) {
+      u16Chunk = u16Len;
+    }
+    uart_tx_enqueue(psRing, (const char*) psLog->pu8Buf + u16Begin, u16Chunk);
+    psLog->u16Tail += u16Chunk;
+    u16Moved += u16Chunk;
+    u16Len -= u16Chunk;
+  }
+  return u16Moved;
+}
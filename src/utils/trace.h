@@ -0,0 +1,92 @@
+/*
+ * Copyright 2025 SZIGETI János
+ *
+ * This file is part of Bilis ESP32 Basic, which is released under GNU General Public License.version 3.
+ * See LICENSE or <https://www.gnu.org/licenses/> for full license details.
+ */
+/** @file trace.h
+ * Deferred-format binary trace logging.
+ * The device does not format the log messages: a TRACEn() call records the ID of its format string
+ * and its raw (32 bit) arguments into a ring buffer. The format strings are placed into the
+ * .trace_fmt section, which is not loaded to the device (see ld/esp32.ld); the ID of a format string
+ * is its offset in this section. trace_flush() ships the recorded frames to a UART TX ring, and
+ * scripts/tracedecode.py reconstructs the text on the host from the ELF file.
+ *
+ * Frame layout: TRACE_SYNC, number of arguments, format ID (16 bit LE), arguments (32 bit LE each),
+ * checksum (8 bit sum of the bytes after TRACE_SYNC).
+ * Only integer conversions (%d %i %u %x %X %o %c, with flags and width) are supported in the format strings.
+ */
+#ifndef TRACE_H
+#define TRACE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "uartutils.h"
+
+#define TRACE_SYNC 0xA5U    ///< First byte of a frame.
+#define TRACE_MAXARGS 4U    ///< Max. number of arguments of a trace call.
+#define TRACE_FRAME_LEN(N) (5U + 4U * (N)) ///< Length of a frame with N arguments.
+
+#define TRACE_FMT_ATTR __attribute__((section(".trace_fmt"), used))
+
+#define _TRACE_REC(psLog, pcFmt, u8Argc, ...) \
+  do { \
+    static const char _acTraceFmt[] TRACE_FMT_ATTR = pcFmt; \
+    const uint32_t _au32TraceArgs[] = {0, ##__VA_ARGS__}; \
+    trace_record((psLog), (uint16_t) (uintptr_t) _acTraceFmt, (u8Argc), _au32TraceArgs + 1); \
+  } while (0)
+
+#define TRACE0(psLog, pcFmt) _TRACE_REC(psLog, pcFmt, 0)
+#define TRACE1(psLog, pcFmt, a) _TRACE_REC(psLog, pcFmt, 1, (uint32_t) (a))
+#define TRACE2(psLog, pcFmt, a, b) _TRACE_REC(psLog, pcFmt, 2, (uint32_t) (a), (uint32_t) (b))
+#define TRACE3(psLog, pcFmt, a, b, c) _TRACE_REC(psLog, pcFmt, 3, (uint32_t) (a), (uint32_t) (b), (uint32_t) (c))
+#define TRACE4(psLog, pcFmt, a, b, c, d) \
+  _TRACE_REC(psLog, pcFmt, 4, (uint32_t) (a), (uint32_t) (b), (uint32_t) (c), (uint32_t) (d))
+
+  /**
+   * Trace ring buffer. The head and tail indices are free-running, the buffer size must be a power of 2.
+   * There must be only one producer (e.g. one ring for the program cycle of a CPU, another one for an ISR).
+   */
+  typedef struct {
+    uint8_t *pu8Buf;           ///< Ring buffer.
+    uint16_t u16Mask;          ///< Size of the ring buffer - 1.
+    volatile uint16_t u16Head; ///< Index of the next byte to record.
+    volatile uint16_t u16Tail; ///< Index of the next byte to ship.
+    uint32_t u32Dropped;       ///< Number of dropped frames (statistics).
+  } STraceLog;
+
+  /**
+   * Initializes a trace ring.
+   * @param pu8Buf Ring buffer.
+   * @param u16Size Size of the ring buffer (power of 2, at most 32768).
+   * @return Initialized trace ring.
+   */
+  STraceLog trace_init(uint8_t *pu8Buf, uint16_t u16Size);
+
+  /**
+   * Records a frame (use the TRACEn() macros instead). If the frame does not fit, it is dropped.
+   * @param psLog Trace ring.
+   * @param u16FmtId Format ID.
+   * @param u8Argc Number of arguments.
+   * @param pu32Args Arguments.
+   * @return The frame is recorded.
+   */
+  bool trace_record(STraceLog *psLog, uint16_t u16FmtId, uint8_t u8Argc, const uint32_t *pu32Args);
+
+  /**
+   * Moves the recorded frames into a UART TX ring (as many whole frames as fit, a frame is never split).
+   * @param psLog Trace ring.
+   * @param psRing UART TX ring.
+   * @return Number of bytes moved.
+   */
+  uint16_t trace_flush(STraceLog *psLog, SUartTxRing *psRing);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TRACE_H */
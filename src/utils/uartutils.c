@@ -19,18 +19,237 @@
 #define _vsnprintf_r(X,Y1,Y2,Y3,Y4) vsnprintf(Y1,Y2,Y3,Y4)
 #endif
 #include <stdlib.h>
+#include "esp_attr.h"
+#include "dport.h"
+#include "romfunctions.h"
 #include "uartutils.h"
 #include "typeaux.h"
 
+#define UART_NUM 3U
+#define UART_INT_RXFIFO_FULL (1U << 0)
+#define UART_INT_TXFIFO_EMPTY (1U << 1)
+#define UART_INT_RXFIFO_TOUT (1U << 8)
+#define UART_STATUS_RXFIFO_CNT_SHIFT 0U
+#define UART_STATUS_TXFIFO_CNT_SHIFT 16U
+#define UART_CONF1_RXFIFO_FULL_THRHD_SHIFT 0U
+#define UART_CONF1_RXFIFO_FULL_THRHD_MASK (0x7FU << UART_CONF1_RXFIFO_FULL_THRHD_SHIFT)
+#define UART_CONF1_TXFIFO_EMPTY_THRHD_SHIFT 8U
+#define UART_CONF1_TXFIFO_EMPTY_THRHD_MASK (0x7FU << UART_CONF1_TXFIFO_EMPTY_THRHD_SHIFT)
+#define UART_CONF1_RX_TOUT_THRHD_SHIFT 24U
+#define UART_CONF1_RX_TOUT_THRHD_MASK (0x7FU << UART_CONF1_RX_TOUT_THRHD_SHIFT)
+#define UART_CONF1_RX_TOUT_EN (1U << 31)
+
+// ============= Local types ===============
+
+/**
+ * Rings served by the interrupt of a UART.
+ */
+typedef struct {
+  SUartTxRing *psTx;
+  SUartRxRing *psRx;
+} SUartIsrDesc;
+
+// ================ Local function declarations =================
+static int _uart_index(const UART_Type *psUART);
+static inline uint8_t _txfifo_cnt(const UART_Type *psUART);
+static inline uint8_t _rxfifo_cnt(const UART_Type *psUART);
+static void _tx_fill(SUartTxRing *psRing);
+static void _rx_drain(SUartRxRing *psRing);
+static void _uart_isr(void *pvParam);
+static void _isr_bind(int iIdx, ECpu eCpu, uint8_t u8IntChannel);
+
+// ==================== Local Data ================
+static SUartIsrDesc gasUartIsr[UART_NUM]; ///< Started rings (by UART index).
+
+// ==================== Implementation ================
+
+/**
+ * @param psUART UART peripheral.
+ * @return Index of the UART, or -1.
+ */
+static int _uart_index(const UART_Type *psUART) {
+  if (psUART == &gsUART0 || psUART == &gsUART0Mapped) return 0;
+  if (psUART == &gsUART1 || psUART == &gsUART1Mapped) return 1;
+  if (psUART == &gsUART2 || psUART == &gsUART2Mapped) return 2;
+  return -1;
+}
+
+static inline uint8_t _txfifo_cnt(const UART_Type *psUART) {
+  return (psUART->STATUS >> UART_STATUS_TXFIFO_CNT_SHIFT) & 0xFF;
+}
+
+static inline uint8_t _rxfifo_cnt(const UART_Type *psUART) {
+  return (psUART->STATUS >> UART_STATUS_RXFIFO_CNT_SHIFT) & 0xFF;
+}
+
+/**
+ * Moves bytes from the ring into the TX FIFO while there is free space,
+ * and enables the TXFIFO_EMPTY interrupt only if the ring is not drained.
+ * @param psRing TX ring.
+ */
+static void IRAM_ATTR _tx_fill(SUartTxRing *psRing) {
+  UART_Type *psUART = psRing->psUART;
+  uint16_t u16Tail = psRing->u16Tail;
+  uint16_t u16Head = psRing->u16Head;
+  uint8_t u8Room = UART_FIFO_LEN - _txfifo_cnt(psUART);
+
+  for (; 0 < u8Room && u16Tail != u16Head; --u8Room, ++u16Tail) {
+    psUART->FIFO = psRing->pcBuf[u16Tail & psRing->u16Mask];
+  }
+  psRing->u16Tail = u16Tail;
+  if (u16Tail == u16Head) {
+    psUART->INT_ENA &= ~UART_INT_TXFIFO_EMPTY;
+  } else {
+    psUART->INT_ENA |= UART_INT_TXFIFO_EMPTY;
+  }
+}
+
+/**
+ * Moves the received bytes from the RX FIFO into the ring (bytes that do not fit are dropped).
+ * @param psRing RX ring.
+ */
+static void IRAM_ATTR _rx_drain(SUartRxRing *psRing) {
+  UART_Type *psUART = psRing->psUART;
+  uint16_t u16Head = psRing->u16Head;
+
+  for (uint8_t u8Cnt = _rxfifo_cnt(psUART); 0 < u8Cnt; --u8Cnt) {
+    char c = psUART->FIFO;
+    if ((uint16_t) (u16Head - psRing->u16Tail) <= psRing->u16Mask) {
+      psRing->pcBuf[u16Head++ & psRing->u16Mask] = c;
+    } else {
+      ++psRing->u32Overflow;
+    }
+  }
+  psRing->u16Head = u16Head;
+  psUART->INT_CLR = UART_INT_RXFIFO_FULL | UART_INT_RXFIFO_TOUT;
+}
+
+static void IRAM_ATTR _uart_isr(void *pvParam) {
+  SUartIsrDesc *psDesc = (SUartIsrDesc*) pvParam;
+  if (psDesc->psRx) {
+    _rx_drain(psDesc->psRx);
+  }
+  if (psDesc->psTx) {
+    _tx_fill(psDesc->psTx);
+    psDesc->psTx->psUART->INT_CLR = UART_INT_TXFIFO_EMPTY;
+  }
+}
+
+/**
+ * Binds the interrupt of a UART to an interrupt channel of a CPU.
+ */
+static void _isr_bind(int iIdx, ECpu eCpu, uint8_t u8IntChannel) {
+  RegAddr prDportIntMap = (eCpu == CPU_PRO ? &dport_regs()->PRO_UART_INTR_MAP : &dport_regs()->APP_UART_INTR_MAP) + iIdx;
+
+  *prDportIntMap = u8IntChannel;
+  _xtos_set_interrupt_handler_arg(u8IntChannel, _uart_isr, (int) &gasUartIsr[iIdx]);
+  ets_isr_unmask(1 << u8IntChannel);
+}
+
+// ============== Interface functions ==============
+
+SUartTxRing uart_tx_init(UART_Type *psUART, char *pcBuf, uint16_t u16Size) {
+  SUartTxRing sRet = {
+    .psUART = psUART,
+    .pcBuf = pcBuf,
+    .u16Mask = u16Size - 1,
+    .u16Head = 0,
+    .u16Tail = 0,
+    .u8IntChannel = 0,
+    .u32Dropped = 0
+  };
+  return sRet;
+}
+
+void uart_tx_isr_start(SUartTxRing *psRing, ECpu eCpu, uint8_t u8IntChannel) {
+  int iIdx = _uart_index(psRing->psUART);
+  if (iIdx < 0) return;
+
+  psRing->u8IntChannel = u8IntChannel;
+  psRing->psUART->INT_ENA &= ~UART_INT_TXFIFO_EMPTY;
+  register_set_bits(&psRing->psUART->CONF1, UART_TX_EMPTY_THRESHOLD << UART_CONF1_TXFIFO_EMPTY_THRHD_SHIFT,
+          UART_CONF1_TXFIFO_EMPTY_THRHD_MASK);
+  psRing->psUART->INT_CLR = UART_INT_TXFIFO_EMPTY;
+  gasUartIsr[iIdx].psTx = psRing;
+  _isr_bind(iIdx, eCpu, u8IntChannel);
+}
+
+bool uart_tx_enqueue(SUartTxRing *psRing, const char *pcData, uint16_t u16Len) {
+  if (uart_tx_free(psRing) < u16Len) {
+    ++psRing->u32Dropped;
+    return false;
+  }
+  uint16_t u16Head = psRing->u16Head;
+  for (uint16_t i = 0; i < u16Len; ++i, ++u16Head) {
+    psRing->pcBuf[u16Head & psRing->u16Mask] = pcData[i];
+  }
+  psRing->u16Head = u16Head;
+  // the ISR also modifies INT_ENA and the tail
+  ets_isr_mask(1 << psRing->u8IntChannel);
+  _tx_fill(psRing);
+  ets_isr_unmask(1 << psRing->u8IntChannel);
+  return true;
+}
+
+SUartRxRing uart_rx_init(UART_Type *psUART, char *pcBuf, uint16_t u16Size) {
+  SUartRxRing sRet = {
+    .psUART = psUART,
+    .pcBuf = pcBuf,
+    .u16Mask = u16Size - 1,
+    .u16Head = 0,
+    .u16Tail = 0,
+    .u32Overflow = 0
+  };
+  return sRet;
+}
+
+void uart_rx_isr_start(SUartRxRing *psRing, ECpu eCpu, uint8_t u8IntChannel) {
+  int iIdx = _uart_index(psRing->psUART);
+  if (iIdx < 0) return;
+
+  register_set_bits(&psRing->psUART->CONF1,
+          (UART_RX_FULL_THRESHOLD << UART_CONF1_RXFIFO_FULL_THRHD_SHIFT)
+          | (UART_RX_TOUT_THRESHOLD << UART_CONF1_RX_TOUT_THRHD_SHIFT) | UART_CONF1_RX_TOUT_EN,
+          UART_CONF1_RXFIFO_FULL_THRHD_MASK | UART_CONF1_RX_TOUT_THRHD_MASK | UART_CONF1_RX_TOUT_EN);
+  psRing->psUART->INT_CLR = UART_INT_RXFIFO_FULL | UART_INT_RXFIFO_TOUT;
+  gasUartIsr[iIdx].psRx = psRing;
+  psRing->psUART->INT_ENA |= UART_INT_RXFIFO_FULL | UART_INT_RXFIFO_TOUT;
+  _isr_bind(iIdx, eCpu, u8IntChannel);
+}
+
+bool uart_rx_getc(SUartRxRing *psRing, char *pc) {
+  uint16_t u16Tail = psRing->u16Tail;
+  if (u16Tail == psRing->u16Head) {
+    return false;
+  }
+  *pc = psRing->pcBuf[u16Tail & psRing->u16Mask];
+  psRing->u16Tail = u16Tail + 1;
+  return true;
+}
+
+void uart_write(UART_Type *psUART, const char *pcData, uint16_t u16Len) {
+  for (uint16_t i = 0; i < u16Len; ++i) {
+    while (UART_FIFO_LEN <= _txfifo_cnt(psUART)) {
+    }
+    psUART->FIFO = pcData[i];
+  }
+}
+
 int uart_printf(UART_Type *psUART, const char *pcFormat, ...) {
   char acBuf[100];
   va_list va;
   va_start(va, pcFormat);
   int iLen = _vsnprintf_r(IMPURE_PTR, acBuf, ARRAY_SIZE(acBuf), pcFormat, va);
   va_end(va);
-  for (int i = 0; i < iLen; ++i) {
-    psUART->FIFO = acBuf[i];
+  if (iLen < 0) return iLen;
+  if ((int) ARRAY_SIZE(acBuf) <= iLen) {
+    iLen = ARRAY_SIZE(acBuf) - 1;
+  }
+  int iIdx = _uart_index(psUART);
+  if (0 <= iIdx && gasUartIsr[iIdx].psTx) {
+    uart_tx_enqueue(gasUartIsr[iIdx].psTx, acBuf, iLen);
+  } else {
+    uart_write(psUART, acBuf, iLen);
   }
   return iLen;
 }
-
@@ -4,6 +4,15 @@
  * This file is part of Bilis ESP32 Basic, which is released under GNU General Public License.version 3.
  * See LICENSE or <https://www.gnu.org/licenses/> for full license details.
  */
+/** @file uartutils.h
+ * UART input / output helpers.
+ * Without a TX ring, the output functions wait for free space in the hardware TX FIFO.
+ * With a TX ring (uart_tx_init(), uart_tx_isr_start()), the output is copied into a software ring buffer
+ * and the TX FIFO is refilled from the TXFIFO_EMPTY interrupt: enqueueing never blocks.
+ * If a message does not fit into the ring, the whole message is dropped (and counted).
+ * An RX ring (uart_rx_init(), uart_rx_isr_start()) is filled from the RXFIFO_FULL and RXFIFO_TOUT interrupts.
+ * The TX and RX rings of a UART share its interrupt (use the same interrupt channel for both).
+ */
 #ifndef UARTUTILS_H
 #define UARTUTILS_H
 
@@ -11,8 +20,122 @@
 extern "C" {
 #endif
 
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp32types.h"
 #include "uart.h"
 
+#define UART_FIFO_LEN 128U          ///< Size of the hardware TX FIFO.
+#define UART_TX_EMPTY_THRESHOLD 32U ///< The TX FIFO is refilled when fewer bytes are left in it.
+#define UART_RX_FULL_THRESHOLD 64U  ///< The RX FIFO is drained when it contains more bytes.
+#define UART_RX_TOUT_THRESHOLD 10U  ///< The RX FIFO is drained after this idle time (in byte periods).
+
+  /**
+   * Software TX ring of a UART.
+   * The head and tail indices are free-running, the buffer size must be a power of 2.
+   * Producer: the program (enqueue functions), consumer: the TXFIFO_EMPTY interrupt.
+   */
+  typedef struct {
+    UART_Type *psUART;
+    char *pcBuf;                ///< Ring buffer.
+    uint16_t u16Mask;           ///< Size of the ring buffer - 1.
+    volatile uint16_t u16Head;  ///< Index of the next byte to enqueue.
+    volatile uint16_t u16Tail;  ///< Index of the next byte to move into the TX FIFO.
+    uint8_t u8IntChannel;       ///< Interrupt channel of the UART.
+    uint32_t u32Dropped;        ///< Number of dropped messages (statistics).
+  } SUartTxRing;
+
+  /**
+   * Software RX ring of a UART.
+   * The head and tail indices are free-running, the buffer size must be a power of 2.
+   * Producer: the RX interrupts, consumer: the program (uart_rx_getc()).
+   */
+  typedef struct {
+    UART_Type *psUART;
+    char *pcBuf;                ///< Ring buffer.
+    uint16_t u16Mask;           ///< Size of the ring buffer - 1.
+    volatile uint16_t u16Head;  ///< Index of the next received byte.
+    volatile uint16_t u16Tail;  ///< Index of the next byte to read.
+    uint32_t u32Overflow;       ///< Number of dropped bytes (statistics).
+  } SUartRxRing;
+
+  /**
+   * Initializes a TX ring.
+   * @param psUART UART peripheral.
+   * @param pcBuf Ring buffer.
+   * @param u16Size Size of the ring buffer (power of 2, at most 32768).
+   * @return Initialized TX ring.
+   */
+  SUartTxRing uart_tx_init(UART_Type *psUART, char *pcBuf, uint16_t u16Size);
+
+  /**
+   * Binds the TX interrupt of the UART to an interrupt channel of a CPU.
+   * After this, uart_printf() on the same UART uses the ring.
+   * The ring must not be moved, and it should be filled on the same CPU.
+   * @param psRing TX ring.
+   * @param eCpu CPU that will run the ISR.
+   * @param u8IntChannel Interrupt channel to use for UART interrupts.
+   */
+  void uart_tx_isr_start(SUartTxRing *psRing, ECpu eCpu, uint8_t u8IntChannel);
+
+  /**
+   * @param psRing TX ring.
+   * @return Number of bytes that can be enqueued.
+   */
+  static inline uint16_t uart_tx_free(const SUartTxRing *psRing) {
+    return psRing->u16Mask + 1 - (uint16_t) (psRing->u16Head - psRing->u16Tail);
+  }
+
+  /**
+   * Enqueues a message (non-blocking). The message is either enqueued as a whole or dropped.
+   * @param psRing TX ring.
+   * @param pcData Message.
+   * @param u16Len Length of the message.
+   * @return The message is enqueued.
+   */
+  bool uart_tx_enqueue(SUartTxRing *psRing, const char *pcData, uint16_t u16Len);
+
+  /**
+   * Initializes an RX ring.
+   * @param psUART UART peripheral.
+   * @param pcBuf Ring buffer.
+   * @param u16Size Size of the ring buffer (power of 2, at most 32768).
+   * @return Initialized RX ring.
+   */
+  SUartRxRing uart_rx_init(UART_Type *psUART, char *pcBuf, uint16_t u16Size);
+
+  /**
+   * Enables the RX interrupts of the UART and binds them to an interrupt channel of a CPU.
+   * The ring must not be moved.
+   * @param psRing RX ring.
+   * @param eCpu CPU that will run the ISR.
+   * @param u8IntChannel Interrupt channel to use for UART interrupts.
+   */
+  void uart_rx_isr_start(SUartRxRing *psRing, ECpu eCpu, uint8_t u8IntChannel);
+
+  /**
+   * Reads a received byte (non-blocking).
+   * @param psRing RX ring.
+   * @param pc Destination of the byte.
+   * @return There was a received byte.
+   */
+  bool uart_rx_getc(SUartRxRing *psRing, char *pc);
+
+  /**
+   * Writes data into the TX FIFO, waiting for free space if necessary.
+   * @param psUART UART peripheral.
+   * @param pcData Data.
+   * @param u16Len Length of data.
+   */
+  void uart_write(UART_Type *psUART, const char *pcData, uint16_t u16Len);
+
+  /**
+   * Formatted output (at most 99 characters). If a TX ring is started on the UART, the message is enqueued
+   * (or dropped), otherwise it is written with uart_write().
+   * @param psUART UART peripheral.
+   * @param pcFormat Format string.
+   * @return Length of the message.
+   */
   int uart_printf(UART_Type *psUART, const char *pcFormat, ...);
 
 #ifdef __cplusplus
@@ -20,4 +143,3 @@ extern "C" {
 #endif
 
 #endif /* UARTUTILS_H */
-
@@ -78,6 +78,16 @@ extern "C" {
 #endif // SOC_CPU_CORES_NUM > 1
   }
 
+  /* Taken from https://github.com/espressif/esp-idf/blob/master/components/xtensa/include/xt_utils.h
+   * which is released under SPDX-License-Identifier: Apache-2.0 */
+  FORCE_INLINE_ATTR uint32_t xt_utils_get_cycle_count(void) {
+    uint32_t ccount;
+    __asm__ __volatile__ (
+            "rsr %0, ccount"
+            : "=r"(ccount));
+    return ccount;
+  }
+
 #else
   FORCE_INLINE_ATTR bool xt_utils_compare_and_set(volatile uint32_t *addr, uint32_t compare_value, uint32_t new_value) {
     return true;
@@ -85,6 +95,9 @@ extern "C" {
   FORCE_INLINE_ATTR __attribute__ ((pure)) uint32_t xt_utils_get_core_id(void) {
     return 0U;
   }
+  FORCE_INLINE_ATTR uint32_t xt_utils_get_cycle_count(void) {
+    return 0U;
+  }
 #endif // __XTENSA__
   
 #ifdef __cplusplus